@@ -0,0 +1,34 @@
+//
+// file: ConvolutionGemm.h
+// desc: ACS Final Project Convolution-as-GEMM Header
+// auth: Andrew Prata
+//
+// This program computes a batch of convolution kernels
+// as a single matrix multiplication: image patches are
+// lowered to columns (im2col) and multiplied by a
+// matrix holding one kernel per row, using the GEMM
+// from Project 2. The edge filters and the Gaussian
+// blur are built on top of it.
+//
+
+#pragma once
+
+#include "Grayscale.h" // Image data structure
+
+// Raw responses of every kernel in one GEMM: output f holds width * height sums (row-major), with
+//  kernels[f][a][b] weighting pixel (x + a - r, y + b - r) as in the direct loops of Grayscale.cpp.
+//  Kernels must be square, odd-sized and all the same size; pixels within r of the border are 0.
+std::vector<std::vector<int>> convolveBatchGemm(const Grayscale& input,
+                                                const std::vector<std::vector<std::vector<int>>>& kernels);
+
+// Sobel (thresholded gradient magnitude) and Laplacian in one GEMM.
+//  Outputs must be preallocated at the input's size; results match sobelOperator and
+//  laplacianOperator pixel for pixel.
+void edgeFiltersGemm(const Grayscale& input, int threshold, bool binary,
+                     Grayscale& sobelOutput, Grayscale& laplacianOutput);
+
+// Normalized convolution (sum / weight sum) through the GEMM; matches convolution pixel for pixel
+Grayscale convolutionGemm(const Grayscale& input, const std::vector<std::vector<int>>& kernel);
+
+// Gaussian blur through the GEMM; matches gaussianBlur pixel for pixel
+Grayscale gaussianBlurGemm(const Grayscale& input, const int kernelSize);
@@ -115,6 +115,11 @@ unsigned Grayscale::getHeight() const {
     return height;
 }
 
+// Get the raw pixel data (row-major, width * height bytes)
+const unsigned char* Grayscale::getData() const {
+    return data;
+}
+
 // Image inverter (created for testing I/O)
 Grayscale invert(const Grayscale& input) {
     unsigned width = input.getWidth();
@@ -130,45 +135,43 @@ Grayscale invert(const Grayscale& input) {
     return output;
 }
 
-// Apply Gaussian Blur
-Grayscale gaussianBlur(const Grayscale& input, const int kernelSize) {
-    unsigned width = input.getWidth();
-    unsigned height = input.getHeight();
-    Grayscale output(width, height);
-
-    // Choose the Gaussian blur kernel based on the provided size
-    std::vector<std::vector<int>> gaussianKernel;
-    int kernelRadius;
+// Gaussian blur kernel of the given size (3, 5 or 7)
+std::vector<std::vector<int>> gaussianKernel(const int kernelSize) {
     // https://www.youtube.com/watch?v=C_zFhWdM4ic
     switch (kernelSize) {
         case 3:
-            gaussianKernel = {{1, 2, 1},
-                              {2, 4, 2},
-                              {1, 2, 1}};
-            kernelRadius = 1;
-            break;
+            return {{1, 2, 1},
+                    {2, 4, 2},
+                    {1, 2, 1}};
         case 5:
-            gaussianKernel = {{1, 4,  7,  4,  1},
-                              {4, 16, 26, 16, 4},
-                              {7, 26, 41, 26, 7},
-                              {4, 16, 26, 16, 4},
-                              {1, 4,  7,  4,  1}};
-            kernelRadius = 2;
-            break;
+            return {{1, 4,  7,  4,  1},
+                    {4, 16, 26, 16, 4},
+                    {7, 26, 41, 26, 7},
+                    {4, 16, 26, 16, 4},
+                    {1, 4,  7,  4,  1}};
         case 7:
-            gaussianKernel = {{0, 0,  1,  2,  1,   0,  0},
-                              {0, 3,  13, 22,  13, 3,  0},
-                              {1, 13, 59, 97,  59, 13, 1},
-                              {2, 22, 97, 159, 97, 22, 2},
-                              {1, 13, 59, 97,  59, 13, 1},
-                              {0, 3,  13, 22,  13, 3,  0},
-                              {0, 0,  1,  2,   1,  0,  0}};
-            kernelRadius = 3;
-            break;
+            return {{0, 0,  1,  2,  1,   0,  0},
+                    {0, 3,  13, 22,  13, 3,  0},
+                    {1, 13, 59, 97,  59, 13, 1},
+                    {2, 22, 97, 159, 97, 22, 2},
+                    {1, 13, 59, 97,  59, 13, 1},
+                    {0, 3,  13, 22,  13, 3,  0},
+                    {0, 0,  1,  2,   1,  0,  0}};
         default:
             std::cerr << "Unsupported kernel size for Gaussian blur." << std::endl;
             std::exit(EXIT_FAILURE);
     }
+}
+
+// Apply Gaussian Blur
+Grayscale gaussianBlur(const Grayscale& input, const int kernelSize) {
+    unsigned width = input.getWidth();
+    unsigned height = input.getHeight();
+    Grayscale output(width, height);
+
+    // Choose the Gaussian blur kernel based on the provided size
+    std::vector<std::vector<int>> gaussianKernel = ::gaussianKernel(kernelSize);
+    int kernelRadius = kernelSize / 2;
 
     // Iterate over the input image, excluding edges (kernel would overlap image)
     for (unsigned y = kernelRadius; y < height - kernelRadius; ++y) {
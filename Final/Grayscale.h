@@ -32,9 +32,11 @@ public:
     unsigned char getPixel(unsigned x, unsigned y) const;
     unsigned getWidth() const;
     unsigned getHeight() const;
+    const unsigned char* getData() const;
 };
 
 Grayscale invert(const Grayscale& input);
+std::vector<std::vector<int>> gaussianKernel(const int kernelSize);
 Grayscale gaussianBlur(const Grayscale& input, const int kernelSize);
 Grayscale meanBlur(const Grayscale& input);
 Grayscale sobelOperator(const Grayscale& input, int threshold, bool binary);
@@ -7,18 +7,80 @@
 // functionality, emphasizing edge-detection.
 //
 
-#include "Grayscale.h" // Image data structure
+#include <chrono>              // Benchmark timers
+#include "Grayscale.h"         // Image data structure
+#include "ConvolutionGemm.h"   // Batched kernels as one GEMM
+
+// Function to compare the direct Sobel + Laplacian and Gaussian blur loops with the im2col GEMM versions
+int benchmarkEdgeGemm(Grayscale& input, const std::string& outputPath) {
+    unsigned width = input.getWidth();
+    unsigned height = input.getHeight();
+    const int threshold = 100;
+
+    // Direct loops: two passes over the image, one per operator
+    auto startDirect = std::chrono::high_resolution_clock::now();
+    Grayscale sobelDirect = sobelOperator(input, threshold, false);
+    Grayscale laplacianDirect = laplacianOperator(input);
+    auto stopDirect = std::chrono::high_resolution_clock::now();
+
+    // GEMM: Sobel X, Sobel Y and Laplacian from one multiplication
+    Grayscale sobelGemm(width, height);
+    Grayscale laplacianGemm(width, height);
+    auto startGemm = std::chrono::high_resolution_clock::now();
+    edgeFiltersGemm(input, threshold, false, sobelGemm, laplacianGemm);
+    auto stopGemm = std::chrono::high_resolution_clock::now();
+
+    double direct = std::chrono::duration<double>(stopDirect - startDirect).count();
+    double gemm = std::chrono::duration<double>(stopGemm - startGemm).count();
+    unsigned mismatches = 0;
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            mismatches += sobelDirect.getPixel(x, y) != sobelGemm.getPixel(x, y);
+            mismatches += laplacianDirect.getPixel(x, y) != laplacianGemm.getPixel(x, y);
+        }
+    }
+    std::cout << "Image " << width << " x " << height << std::endl;
+    std::cout << " Direct loops (sobelOperator + laplacianOperator): " << direct << " seconds" << std::endl;
+    std::cout << " im2col GEMM (edgeFiltersGemm): " << gemm << " seconds (" << direct / gemm << "x)" << std::endl;
+
+    // Gaussian blur: direct loops vs the same batched GEMM with a single 5x5 kernel
+    auto startBlurDirect = std::chrono::high_resolution_clock::now();
+    Grayscale blurDirect = gaussianBlur(input, 5);
+    auto stopBlurDirect = std::chrono::high_resolution_clock::now();
+    Grayscale blurGemm = gaussianBlurGemm(input, 5);
+    auto stopBlurGemm = std::chrono::high_resolution_clock::now();
+    double blurDirectSeconds = std::chrono::duration<double>(stopBlurDirect - startBlurDirect).count();
+    double blurGemmSeconds = std::chrono::duration<double>(stopBlurGemm - stopBlurDirect).count();
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            mismatches += blurDirect.getPixel(x, y) != blurGemm.getPixel(x, y);
+        }
+    }
+    std::cout << " Direct loops (gaussianBlur 5x5): " << blurDirectSeconds << " seconds" << std::endl;
+    std::cout << " im2col GEMM (gaussianBlurGemm 5x5): " << blurGemmSeconds << " seconds ("
+              << blurDirectSeconds / blurGemmSeconds << "x)" << std::endl;
+    std::cout << " Results " << (mismatches == 0 ? "match" : "DIFFER") << " (" << mismatches
+              << " mismatching pixels)" << std::endl;
+
+    sobelGemm.exportPNG(outputPath);
+    return mismatches == 0 ? 0 : 1;
+}
 
 int main(int argc, char* argv[]) {
     if (argc < 4) { // Ensure correct commandline arguments
         std::cerr << "Usage: " << argv[0] << " <path/to/input_image.png>"
-            " <path/to/output_image.png> <operation [0-9]>" << std::endl;
+            " <path/to/output_image.png> <operation [0-9] | gemm>" << std::endl;
         return 1;   // Return an error code
     }
 
     // Create a Grayscale object from input PNG
     Grayscale input_image((std::string)argv[1]);
 
+    // Edge detection as one matrix multiplication, benchmarked against the direct loops
+    if ((std::string)argv[3] == "gemm") {
+        return benchmarkEdgeGemm(input_image, (std::string)argv[2]);
+    }
+
     Grayscale median_image = medianFilter(input_image, 2);
 
     Grayscale equalized = histogramEqualization(median_image);
@@ -26,4 +88,4 @@ int main(int argc, char* argv[]) {
     equalized.exportPNG((std::string)argv[2]);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,246 @@
+//
+// file: AsyncGemm.h
+// desc: ACS Project 2 Asynchronous Multiplication Header
+// auth: Andrew Prata
+//
+// This header file contains a persistent worker pool
+// that accepts multiplications and returns futures.
+// Each job is split into row blocks, and workers take
+// one block at a time from the outstanding jobs in
+// round-robin order, so concurrent products share the
+// threads fairly. Include it after Matrix.h.
+//
+
+// Queue depth and latency summary for a GemmService
+struct GemmServiceReport {
+    size_t submitted = 0;       // Jobs accepted so far
+    size_t completed = 0;       // Jobs whose future is ready
+    size_t queueDepth = 0;      // Jobs currently outstanding
+    size_t maxQueueDepth = 0;   // Most jobs outstanding at once
+    double meanWaitMs = 0;      // Submit -> first block started
+    double meanLatencyMs = 0;   // Submit -> future ready
+    double maxLatencyMs = 0;
+};
+
+// Persistent pool executing block-split multiplications
+class GemmService {
+private:
+    using clock = std::chrono::high_resolution_clock;
+
+    // One outstanding multiplication
+    struct Job {
+        std::function<void(size_t, size_t)> runRows; // Compute rows [start, end) of the output
+        std::function<void()> complete;              // Fulfil the promise (called once)
+        std::function<void(std::exception_ptr)> fail;
+        size_t numRows = 0;
+        size_t nextRow = 0;      // Next row block to hand out
+        size_t rowsDone = 0;
+        bool started = false;
+        std::exception_ptr error;
+        clock::time_point submitted;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Job>> active; // Jobs with blocks left to hand out, round robin
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    bool stopping = false;
+    size_t blockRows;
+
+    // Running statistics (protected by queueMutex)
+    size_t outstanding = 0;
+    size_t startedJobs = 0;
+    GemmServiceReport stats;
+    double totalWaitMs = 0;
+    double totalLatencyMs = 0;
+
+    static double millisecondsSince(clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    }
+
+    void workerLoop() {
+        while (true) {
+            std::shared_ptr<Job> job;
+            size_t start = 0;
+            size_t end = 0;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueCondition.wait(lock, [this] { return stopping || !active.empty(); });
+                if (active.empty()) {
+                    return; // Stopping and drained
+                }
+                // Claim one block from the front job, then rotate it to the back
+                job = active.front();
+                active.pop_front();
+                start = job->nextRow;
+                end = std::min(start + blockRows, job->numRows);
+                job->nextRow = end;
+                if (end < job->numRows) {
+                    active.push_back(job);
+                }
+                if (!job->started) {
+                    job->started = true;
+                    ++startedJobs;
+                    totalWaitMs += millisecondsSince(job->submitted);
+                }
+            }
+
+            std::exception_ptr error;
+            try {
+                job->runRows(start, end);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (error && !job->error) {
+                    job->error = error;
+                }
+                job->rowsDone += end - start;
+                if (job->rowsDone == job->numRows) {
+                    last = true;
+                    double latency = millisecondsSince(job->submitted);
+                    totalLatencyMs += latency;
+                    stats.maxLatencyMs = std::max(stats.maxLatencyMs, latency);
+                    ++stats.completed;
+                    --outstanding;
+                }
+            }
+            // The worker that finishes the last block publishes the result
+            if (last) {
+                if (job->error) {
+                    job->fail(job->error);
+                } else {
+                    job->complete();
+                }
+            }
+        }
+    }
+
+    void enqueue(std::shared_ptr<Job> job) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            job->submitted = clock::now();
+            ++stats.submitted;
+            ++outstanding;
+            stats.maxQueueDepth = std::max(stats.maxQueueDepth, outstanding);
+            if (job->numRows == 0) {
+                --outstanding;
+                ++stats.completed;
+            } else {
+                active.push_back(job);
+            }
+        }
+        if (job->numRows == 0) {
+            job->complete();
+        } else {
+            queueCondition.notify_all();
+        }
+    }
+
+public:
+    // Constructor (numThreads = 0 uses every hardware thread, blockRows = rows per work item)
+    explicit GemmService(size_t numThreads = 0, size_t blockRows = 32) : blockRows(blockRows) {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < numThreads; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    // Finishes every outstanding job before the workers exit
+    ~GemmService() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueCondition.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Enqueue C = A x B and return at once (A and B must stay alive until the future is ready)
+    template <typename T>
+    std::future<Matrix<T>> submit(Matrix<T>& A, Matrix<T>& B) {
+        if (A.numCols() != B.numRows()) {
+            throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+        }
+        auto result = std::make_shared<Matrix<T>>(A.numRows(), B.numCols());
+        auto promise = std::make_shared<std::promise<Matrix<T>>>();
+        auto job = std::make_shared<Job>();
+        job->numRows = A.numRows();
+        job->runRows = [&A, &B, result](size_t start, size_t end) {
+            mulAddBlockedRows(A, B, *result, start, end);
+        };
+        job->complete = [result, promise] { promise->set_value(std::move(*result)); };
+        job->fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+        std::future<Matrix<T>> future = promise->get_future();
+        enqueue(job);
+        return future;
+    }
+
+    // Enqueue C += A x B into caller-owned C; the future is the completion handle
+    template <typename T>
+    std::future<void> submitInto(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C) {
+        if (A.numCols() != B.numRows() || A.numRows() != C.numRows() || B.numCols() != C.numCols()) {
+            throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+        }
+        auto promise = std::make_shared<std::promise<void>>();
+        auto job = std::make_shared<Job>();
+        job->numRows = A.numRows();
+        job->runRows = [&A, &B, &C](size_t start, size_t end) {
+            mulAddBlockedRows(A, B, C, start, end);
+        };
+        job->complete = [promise] { promise->set_value(); };
+        job->fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+        std::future<void> future = promise->get_future();
+        enqueue(job);
+        return future;
+    }
+
+    // Enqueue body(start, end) over row blocks of [0, numRows); the future is the completion handle
+    template <typename F>
+    std::future<void> submitRows(size_t numRows, F body) {
+        auto promise = std::make_shared<std::promise<void>>();
+        auto job = std::make_shared<Job>();
+        job->numRows = numRows;
+        job->runRows = body;
+        job->complete = [promise] { promise->set_value(); };
+        job->fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+        std::future<void> future = promise->get_future();
+        enqueue(job);
+        return future;
+    }
+
+    // Snapshot of queue depth and latency so far
+    GemmServiceReport report() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        GemmServiceReport snapshot = stats;
+        snapshot.queueDepth = outstanding;
+        snapshot.meanWaitMs = startedJobs ? totalWaitMs / startedJobs : 0;
+        snapshot.meanLatencyMs = stats.completed ? totalLatencyMs / stats.completed : 0;
+        return snapshot;
+    }
+};
+
+// Process-wide service used by mulMatAsync
+inline GemmService& defaultGemmService() {
+    static GemmService service;
+    return service;
+}
+
+// Function to start C = A x B on the shared worker pool and return immediately
+template <typename T>
+std::future<Matrix<T>> mulMatAsync(Matrix<T>& A, Matrix<T>& B) {
+    return defaultGemmService().submit(A, B);
+}
+
+// Function to start C += A x B into an existing matrix and return a completion handle
+template <typename T>
+std::future<void> mulMatAsyncInto(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C) {
+    return defaultGemmService().submitInto(A, B, C);
+}
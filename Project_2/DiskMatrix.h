@@ -0,0 +1,221 @@
+//
+// file: DiskMatrix.h
+// desc: ACS Project 2 Out-of-Core Matrix Header
+// auth: Andrew Prata
+//
+// This header file contains a disk-backed matrix and
+// an out-of-core multiplication that streams tiles of
+// A, B and C through a fixed DRAM budget. Include it
+// after Matrix.h.
+//
+
+// Disk-backed matrix, stored row-major as a raw binary file (no header)
+template <typename T>
+class DiskMatrix {
+private:
+    std::string path;
+    size_t rows;
+    size_t cols;
+
+    // Byte offset of element (row, col) in the file (64-bit, files can exceed 4 GB)
+    std::streamoff offsetOf(size_t row, size_t col) const {
+        return (static_cast<std::streamoff>(row) * cols + col) * static_cast<std::streamoff>(sizeof(T));
+    }
+
+public:
+    // Constructor (create = true sizes a fresh file, otherwise the file must already exist)
+    DiskMatrix(const std::string& path, size_t rows, size_t cols, bool create)
+        : path(path), rows(rows), cols(cols) {
+        if (create) {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not create matrix file " + path);
+            }
+            file.close();
+            std::filesystem::resize_file(path, static_cast<std::uintmax_t>(offsetOf(rows, 0)));
+        } else if (!std::filesystem::exists(path)) {
+            throw std::runtime_error("Matrix file " + path + " does not exist");
+        }
+    }
+
+    // Getter methods for rows, columns and path
+    size_t numRows() const {
+        return rows;
+    }
+
+    size_t numCols() const {
+        return cols;
+    }
+
+    const std::string& filePath() const {
+        return path;
+    }
+
+    // Read the h x w region at (row0, col0) into the top-left of tile, zero-filling the rest
+    void readTile(size_t row0, size_t col0, size_t h, size_t w, Matrix<T>& tile) const {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open matrix file " + path);
+        }
+        for (size_t r = 0; r < tile.numRows(); ++r) {
+            T* dst = tile.rowData(r);
+            if (r < h) {
+                file.seekg(offsetOf(row0 + r, col0));
+                file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(w) * sizeof(T));
+                std::fill(dst + w, dst + tile.numCols(), T(0));
+            } else {
+                std::fill(dst, dst + tile.numCols(), T(0));
+            }
+        }
+        if (!file) {
+            throw std::runtime_error("Short read from matrix file " + path);
+        }
+    }
+
+    // Write the top-left h x w region of tile to (row0, col0) in the file
+    void writeTile(size_t row0, size_t col0, size_t h, size_t w, Matrix<T>& tile) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open matrix file " + path);
+        }
+        for (size_t r = 0; r < h; ++r) {
+            file.seekp(offsetOf(row0 + r, col0));
+            file.write(reinterpret_cast<const char*>(tile.rowData(r)), static_cast<std::streamsize>(w) * sizeof(T));
+        }
+        if (!file) {
+            throw std::runtime_error("Short write to matrix file " + path);
+        }
+    }
+};
+
+// Timing and traffic report for one out-of-core multiplication
+struct OutOfCoreStats {
+    size_t tileSize = 0;         // Edge length of the square tiles held in DRAM
+    unsigned long long residentBytes = 0; // Bytes of tile buffers actually allocated
+    double totalSeconds = 0;     // Wall time of the whole multiplication
+    double computeSeconds = 0;   // Time spent inside the in-memory kernel
+    double ioStallSeconds = 0;   // Time the kernel sat waiting on reads/writes (not hidden by prefetch)
+    unsigned long long bytesRead = 0;
+    unsigned long long bytesWritten = 0;
+};
+
+// Pick the largest tile edge (multiple of 8) whose six buffers (2x A, 2x B, 2x C) fit the budget
+//  Byte counts are 64-bit: size_t is redefined to 32 bits by Matrix.h, and budgets reach 4 GB.
+template <typename T>
+size_t outOfCoreTileSize(unsigned long long memoryBudgetBytes, size_t largestDim) {
+    unsigned long long tile = static_cast<unsigned long long>(
+        std::sqrt(static_cast<double>(memoryBudgetBytes) / (6.0 * sizeof(T))));
+    tile -= tile % 8;
+    if (tile < 8) {
+        throw std::invalid_argument("Memory budget too small for out-of-core multiplication");
+    }
+    unsigned long long largestRounded = ((largestDim + 7ull) / 8) * 8; // No point in tiles larger than the matrix
+    return static_cast<size_t>(std::min(tile, largestRounded));
+}
+
+// Function to perform C = A x B where A, B and C live on disk and only tiles are resident
+//  Tiles are visited as (ti, tj, tk) with tk innermost. While the kernel consumes the A/B pair
+//  for step s, the pair for step s+1 is read into the other half of the double buffer, and
+//  finished C tiles are written back asynchronously from their own double buffer.
+template <typename T>
+OutOfCoreStats mulMatOutOfCore(DiskMatrix<T>& A, DiskMatrix<T>& B, DiskMatrix<T>& C,
+                               unsigned long long memoryBudgetBytes) {
+    if (A.numCols() != B.numRows() || A.numRows() != C.numRows() || B.numCols() != C.numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+
+    using clock = std::chrono::high_resolution_clock;
+    auto seconds = [](clock::time_point a, clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    };
+    auto startTotal = clock::now();
+
+    size_t M = A.numRows();
+    size_t K = A.numCols();
+    size_t N = B.numCols();
+
+    OutOfCoreStats stats;
+    size_t t = outOfCoreTileSize<T>(memoryBudgetBytes, std::max(M, std::max(N, K)));
+    stats.tileSize = t;
+    stats.residentBytes = 6ull * t * t * sizeof(T);
+
+    size_t tilesI = (M + t - 1) / t;
+    size_t tilesJ = (N + t - 1) / t;
+    size_t tilesK = (K + t - 1) / t;
+    size_t totalSteps = tilesI * tilesJ * tilesK;
+
+    // Double buffers (all tiles are t x t, edge tiles are zero padded)
+    std::vector<Matrix<T>> tileA(2, Matrix<T>(t, t));
+    std::vector<Matrix<T>> tileB(2, Matrix<T>(t, t));
+    std::vector<Matrix<T>> tileC(2, Matrix<T>(t, t));
+
+    // Asynchronously read the A/B pair for a given step into buffer slot
+    auto prefetch = [&](size_t step, size_t slot) {
+        size_t ti = step / (tilesJ * tilesK);
+        size_t tj = (step / tilesK) % tilesJ;
+        size_t tk = step % tilesK;
+        return std::async(std::launch::async, [&, ti, tj, tk, slot] {
+            A.readTile(ti * t, tk * t, std::min(t, M - ti * t), std::min(t, K - tk * t), tileA[slot]);
+            B.readTile(tk * t, tj * t, std::min(t, K - tk * t), std::min(t, N - tj * t), tileB[slot]);
+        });
+    };
+    // Wait on an I/O future and charge the time to the stall counter
+    auto waitFor = [&](std::future<void>& pending) {
+        if (pending.valid()) {
+            auto startWait = clock::now();
+            pending.get();
+            stats.ioStallSeconds += seconds(startWait, clock::now());
+        }
+    };
+
+    std::future<void> pendingRead = prefetch(0, 0);
+    std::future<void> pendingWrite[2];
+    size_t cSlot = 0;
+
+    for (size_t step = 0; step < totalSteps; ++step) {
+        size_t ti = step / (tilesJ * tilesK);
+        size_t tj = (step / tilesK) % tilesJ;
+        size_t tk = step % tilesK;
+        size_t slot = step % 2;
+
+        // Current pair must be resident, then immediately start on the next one
+        waitFor(pendingRead);
+        if (step + 1 < totalSteps) {
+            pendingRead = prefetch(step + 1, (step + 1) % 2);
+        }
+        size_t rowsA = std::min(t, M - ti * t);
+        size_t depth = std::min(t, K - tk * t);
+        size_t colsB = std::min(t, N - tj * t);
+        stats.bytesRead += (static_cast<unsigned long long>(rowsA) * depth + depth * colsB) * sizeof(T);
+
+        // First K panel of a C tile: make sure its buffer has been flushed, then clear it
+        if (tk == 0) {
+            waitFor(pendingWrite[cSlot]);
+            for (size_t r = 0; r < t; ++r) {
+                std::fill(tileC[cSlot].rowData(r), tileC[cSlot].rowData(r) + t, T(0));
+            }
+        }
+
+        auto startCompute = clock::now();
+        mulAddBlocked(tileA[slot], tileB[slot], tileC[cSlot]);
+        stats.computeSeconds += seconds(startCompute, clock::now());
+
+        // Last K panel: write the finished C tile back in the background
+        if (tk == tilesK - 1) {
+            size_t h = rowsA;
+            size_t w = colsB;
+            pendingWrite[cSlot] = std::async(std::launch::async, [&C, &tileC, ti, tj, h, w, t, cSlot] {
+                C.writeTile(ti * t, tj * t, h, w, tileC[cSlot]);
+            });
+            stats.bytesWritten += static_cast<unsigned long long>(h) * w * sizeof(T);
+            cSlot ^= 1;
+        }
+    }
+
+    // Drain outstanding writes
+    waitFor(pendingWrite[0]);
+    waitFor(pendingWrite[1]);
+
+    stats.totalSeconds = seconds(startTotal, clock::now());
+    return stats;
+}
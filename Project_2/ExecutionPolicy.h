@@ -0,0 +1,214 @@
+//
+// file: ExecutionPolicy.h
+// desc: ACS Project 2 Execution Policy Header
+// auth: Andrew Prata
+//
+// This header file contains kernels templated on an
+// execution policy, so one kernel body can run
+// sequentially, on hand-rolled std::thread slabs, under
+// std::execution::par_unseq, or on the persistent
+// GemmService pool. The par_unseq backend needs the
+// C++17 parallel algorithms (libstdc++ uses TBB), so it
+// is only built with -DMATTEST_PARALLEL_STL -ltbb.
+// The naive, transposed (CO), SIMD and packed GEMMs
+// all have policy versions over the same row kernels
+// as Matrix.h and PackedGemm.h, and the elementwise
+// operations in MatrixOps.h take a policy argument
+// (addMatWith is addMat). One schedule is not
+// ported: mulMatPacked's helper thread packs B panel
+// p + 1 while the compute threads consume panel p, and
+// the two sides meet at a std::barrier every panel.
+// That needs every participant running at once, which
+// no policy promises (sequential runs one block at a
+// time, a pool may have fewer workers than blocks, and
+// par_unseq forbids blocking), so mulMatPackedWith
+// packs each B panel between row-block passes instead.
+// Include it after AsyncGemm.h, MatrixOps.h and
+// PackedGemm.h.
+//
+
+// SequentialExecution and ThreadSplitExecution live in Matrix.h (elementwise defaults to the latter)
+
+#ifdef MATTEST_PARALLEL_STL
+// Row blocks handed to the standard library scheduler
+struct ParallelUnseqExecution {
+    static constexpr const char* name = "std::execution::par_unseq";
+    size_t blockRows = 16;
+};
+#endif
+
+// Row blocks queued on a persistent GemmService pool
+struct PoolExecution {
+    static constexpr const char* name = "GemmService pool";
+    GemmService& service;
+};
+
+// Helper to run body(startRow, endRow) over [0, numRows) under the given policy
+#ifdef MATTEST_PARALLEL_STL
+template <typename F>
+void forEachRowBlock(const ParallelUnseqExecution& policy, size_t numRows, F body) {
+    size_t blockRows = std::max(1u, policy.blockRows);
+    std::vector<size_t> starts;
+    starts.reserve((numRows + blockRows - 1) / blockRows);
+    for (size_t row = 0; row < numRows; row += blockRows) {
+        starts.push_back(row);
+    }
+    // The body takes no locks and allocates nothing, as par_unseq requires
+    std::for_each(std::execution::par_unseq, starts.begin(), starts.end(), [&](size_t start) {
+        body(start, std::min(start + blockRows, numRows));
+    });
+}
+#endif
+
+template <typename F>
+void forEachRowBlock(const PoolExecution& policy, size_t numRows, F body) {
+    policy.service.submitRows(numRows, body).get(); // Rethrows a failure from any block
+}
+
+// Function to accumulate C += A x B using cache blocking under an execution policy
+template <typename Policy, typename T>
+void mulAddBlockedWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B, Matrix<T>& C) {
+    if (A.numCols() != B.numRows() || A.numRows() != C.numRows() || B.numCols() != C.numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    forEachRowBlock(policy, A.numRows(), [&A, &B, &C](size_t startRow, size_t endRow) {
+        mulAddBlockedRows(A, B, C, startRow, endRow);
+    });
+}
+
+// Function to perform matrix multiplication using cache blocking under an execution policy
+template <typename Policy, typename T>
+Matrix<T> mulMatBlockedWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    Matrix<T> result(A.numRows(), B.numCols(), BufferInit::Zero, A.bufferPolicy()); // Accumulated into
+    mulAddBlockedWith(policy, A, B, result);
+    return result;
+}
+
+// Function to perform "naive" (i-j-k) matrix multiplication under an execution policy (MT path)
+template <typename Policy, typename T>
+Matrix<T> mulMatNaiveWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T> result(A.numRows(), B.numCols(), BufferInit::Uninitialized, A.bufferPolicy()); // Every element is written
+    forEachRowBlock(policy, A.numRows(), [&A, &B, &result](size_t startRow, size_t endRow) {
+        multiplyPartial(A, B, result, startRow, endRow);
+    });
+    return result;
+}
+
+// Helper to transpose B under an execution policy (row blocks of B^T are column blocks of B)
+template <typename Policy, typename T>
+Matrix<T> transposeWith(const Policy& policy, Matrix<T>& B) {
+    Matrix<T> BTransposed(B.numCols(), B.numRows(), BufferInit::Uninitialized, B.bufferPolicy()); // Every element is copied
+    forEachRowBlock(policy, B.numCols(), [&B, &BTransposed](size_t startRow, size_t endRow) {
+        for (size_t i = 0; i < B.numRows(); ++i) {
+            for (size_t j = startRow; j < endRow; ++j) {
+                BTransposed(j, i) = B(i, j);
+            }
+        }
+    });
+    return BTransposed;
+}
+
+// Function to perform matrix multiplication against a transposed B under an execution policy (CO path)
+template <typename Policy, typename T>
+Matrix<T> mulMatTransposedWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T> BTransposed = transposeWith(policy, B);
+    Matrix<T> result(A.numRows(), B.numCols(), BufferInit::Uninitialized, A.bufferPolicy()); // Every element is written
+    forEachRowBlock(policy, A.numRows(), [&A, &BTransposed, &result](size_t startRow, size_t endRow) {
+        mulTransposedRows(A, BTransposed, result, startRow, endRow);
+    });
+    return result;
+}
+
+// Function to perform 8-lane integer SIMD multiplication under an execution policy (SIMD path)
+//  Same kernel as mulMatSIMD: square int matrices with a multiple of 8 columns.
+template <typename Policy, typename T>
+Matrix<T> mulMatSIMDWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T> result(A.numRows(), B.numCols(), BufferInit::Uninitialized, A.bufferPolicy()); // Every element is stored
+    const MemoryHints& hints = memoryHints(SimdKernel::SIMD);
+    size_t distance = hints.prefetchDistance;
+    bool stream = useStreamingStores(hints, 1ull * A.numRows() * B.numCols() * sizeof(T), result.storage(),
+                                     1ull * B.numCols() * sizeof(T));
+    forEachRowBlock(policy, A.numRows(), [&, distance, stream](size_t startRow, size_t endRow) {
+        mulSIMDRows(A, B, result, startRow, endRow, distance, stream);
+    });
+    return result;
+}
+
+// Function to perform 8-lane integer SIMD multiplication against a transposed B under an execution
+//  policy (SIMD CO and MAXIMUM path; same kernel and limits as mulMatSIMD_CO)
+template <typename Policy, typename T>
+Matrix<T> mulMatTransposedSIMDWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T> BTransposed = transposeWith(policy, B);
+    Matrix<T> result(A.numRows(), B.numCols(), BufferInit::Uninitialized, A.bufferPolicy()); // Every element is stored
+    const MemoryHints& hints = memoryHints(SimdKernel::SIMD_CO);
+    size_t distance = hints.prefetchDistance;
+    bool stream = useStreamingStores(hints, 1ull * A.numRows() * B.numCols() * sizeof(T), result.storage(),
+                                     1ull * B.numCols() * sizeof(T));
+    forEachRowBlock(policy, A.numRows(), [&, distance, stream](size_t startRow, size_t endRow) {
+        mulTransposedSIMDRows(A, BTransposed, result, startRow, endRow, distance, stream);
+    });
+    return result;
+}
+
+// Function to multiply with packed operands under an execution policy (packed path)
+//  Blocks are counted in MR-row micro panels, so every block packs whole micro panels of A into
+//  its own slice of one shared buffer (the body allocates nothing). Each B panel is packed on
+//  the calling thread before the pass that consumes it: the overlap = false schedule of mulMatPacked.
+template <typename Policy, typename T>
+Matrix<T> mulMatPackedWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    size_t m = A.numRows();
+    size_t kTotal = A.numCols();
+    size_t n = B.numCols();
+    Matrix<T> C(m, n, BufferInit::Zero, A.bufferPolicy()); // Accumulated into, one K panel at a time
+    size_t microPanels = (m + packedMR - 1) / packedMR;
+    size_t strips = (n + packedNR - 1) / packedNR;
+    if (kTotal == 0 || microPanels == 0 || strips == 0) {
+        return C;
+    }
+    MatrixBuffer<T> packedB(strips * packedKC * packedNR, BufferInit::Uninitialized, A.bufferPolicy());
+    MatrixBuffer<T> packedA(microPanels * packedMR * packedKC, BufferInit::Uninitialized, A.bufferPolicy());
+    for (size_t k0 = 0; k0 < kTotal; k0 += packedKC) {
+        size_t kc = std::min(packedKC, kTotal - k0);
+        packPanelB(B, k0, kc, packedB.data());
+        const T* b = packedB.data();
+        T* arena = packedA.data();
+        forEachRowBlock(policy, microPanels, [&, k0, kc, b, arena](size_t startPanel, size_t endPanel) {
+            size_t row0 = startPanel * packedMR;
+            size_t row1 = std::min(endPanel * packedMR, m);
+            T* a = arena + 1ull * startPanel * packedMR * kc;
+            packPanelA(A, row0, row1, k0, kc, a);
+            for (size_t mp = startPanel; mp < endPanel; ++mp) {
+                size_t row = mp * packedMR;
+                size_t rows = std::min(packedMR, m - row);
+                const T* aPanel = a + 1ull * (mp - startPanel) * packedMR * kc;
+                for (size_t s = 0; s < strips; ++s) {
+                    size_t col = s * packedNR;
+                    packedMicroKernel(aPanel, b + 1ull * s * kc * packedNR, kc,
+                                      C.rowData(row) + col, n, rows, std::min(packedNR, n - col));
+                }
+            }
+        });
+    }
+    return C;
+}
+
+// Function to add two matrices elementwise under an execution policy (the addMat kernel)
+template <typename Policy, typename T>
+Matrix<T> addMatWith(const Policy& policy, Matrix<T>& A, Matrix<T>& B) {
+    return addMat(A, B, policy);
+}
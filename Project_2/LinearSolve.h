@@ -0,0 +1,226 @@
+//
+// file: LinearSolve.h
+// desc: ACS Project 2 LU Factorization Header
+// auth: Andrew Prata
+//
+// This header file contains a right-looking blocked LU
+// factorization with partial pivoting, and the
+// triangular solves needed for solve(A, b). The
+// trailing-matrix update, where nearly all of the
+// FLOPs are, goes through the blocked GEMM kernel.
+// Include it after Matrix.h.
+//
+
+// Result of factorLU: L (unit diagonal, implicit) and U packed in one matrix
+template <typename T>
+struct LUFactorization {
+    Matrix<T> LU;               // Strictly lower part = L, upper part (with diagonal) = U
+    std::vector<size_t> pivots; // Row j was swapped with row pivots[j] at step j (LAPACK ipiv style)
+    bool singular = false;      // An exactly zero pivot was met
+};
+
+// Function to factor the panel A[j0:n, j0:j0+jb] in place with partial pivoting (MT over panel rows)
+//  Each thread owns a slab of panel rows. Per column: every thread finds its local pivot
+//  candidate, thread 0 picks the winner and swaps the two panel rows, then every thread
+//  scales and rank-1 updates its own rows. One barrier per phase keeps them in step.
+template <typename T>
+bool factorPanel(Matrix<T>& A, size_t j0, size_t jb, std::vector<size_t>& pivots) {
+    size_t n = A.numRows();
+    size_t panelRows = n - j0;
+    size_t numThreads = std::max(1u, std::min(std::thread::hardware_concurrency(), panelRows / 256));
+    std::vector<T> localMax(numThreads);
+    std::vector<size_t> localRow(numThreads);
+    std::barrier sync(static_cast<std::ptrdiff_t>(numThreads));
+    bool singular = false;
+
+    auto worker = [&](size_t id) {
+        size_t start = j0 + (id * panelRows) / numThreads;
+        size_t end = j0 + ((id + 1) * panelRows) / numThreads;
+        for (size_t j = j0; j < j0 + jb; ++j) {
+            // Local pivot search over this thread's rows at or below the diagonal
+            T best = T(-1);
+            size_t bestRow = j;
+            for (size_t i = std::max(start, j); i < end; ++i) {
+                T value = std::abs(A.rowData(i)[j]);
+                if (value > best) {
+                    best = value;
+                    bestRow = i;
+                }
+            }
+            localMax[id] = best;
+            localRow[id] = bestRow;
+            sync.arrive_and_wait();
+
+            // Thread 0 picks the global pivot and swaps the panel part of the two rows
+            if (id == 0) {
+                size_t winner = 0;
+                for (size_t t = 1; t < numThreads; ++t) {
+                    if (localMax[t] > localMax[winner]) {
+                        winner = t;
+                    }
+                }
+                size_t p = localRow[winner];
+                pivots[j] = p;
+                if (localMax[winner] <= T(0)) {
+                    singular = true;
+                } else if (p != j) {
+                    std::swap_ranges(A.rowData(j) + j0, A.rowData(j) + j0 + jb, A.rowData(p) + j0);
+                }
+            }
+            sync.arrive_and_wait();
+
+            // Compute the multipliers of this column and update the rest of the panel
+            const T* u = A.rowData(j);
+            T pivot = u[j];
+            if (pivot != T(0)) {
+                for (size_t i = std::max(start, j + 1); i < end; ++i) {
+                    T* r = A.rowData(i);
+                    T l = r[j] / pivot;
+                    r[j] = l;
+                    for (size_t c = j + 1; c < j0 + jb; ++c) {
+                        r[c] -= l * u[c];
+                    }
+                }
+            }
+            // No barrier needed here: the next search only reads this thread's own rows
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t id = 1; id < numThreads; ++id) {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return !singular;
+}
+
+// Function to compute the blocked LU factorization PA = LU (right-looking, partial pivoting)
+template <typename T>
+LUFactorization<T> factorLU(Matrix<T>& A, size_t blockSize = 128) {
+    static_assert(std::is_floating_point_v<T>, "LU factorization requires a floating point type");
+    if (A.numRows() != A.numCols()) {
+        throw std::invalid_argument("LU factorization requires a square matrix");
+    }
+    size_t n = A.numRows();
+    LUFactorization<T> F{A, std::vector<size_t>(n), false};
+    Matrix<T>& M = F.LU;
+
+    for (size_t j0 = 0; j0 < n; j0 += blockSize) {
+        size_t jb = std::min(blockSize, n - j0);
+        size_t rest = j0 + jb; // First column/row of the trailing matrix
+
+        // 1. Factor the panel
+        if (!factorPanel(M, j0, jb, F.pivots)) {
+            F.singular = true;
+        }
+
+        // 2. Apply the panel's row swaps to the columns left and right of it
+        for (size_t j = j0; j < rest; ++j) {
+            size_t p = F.pivots[j];
+            if (p != j) {
+                std::swap_ranges(M.rowData(j), M.rowData(j) + j0, M.rowData(p));
+                std::swap_ranges(M.rowData(j) + rest, M.rowData(j) + n, M.rowData(p) + rest);
+            }
+        }
+        if (rest == n) {
+            break;
+        }
+
+        // 3. U12 = L11^-1 A12 (unit lower triangular solve, MT over column chunks of A12)
+        size_t trailing = n - rest;
+        forEachRowSlab(trailing, [&](size_t cStart, size_t cEnd) {
+            for (size_t i = j0 + 1; i < rest; ++i) {
+                T* row = M.rowData(i);
+                for (size_t k = j0; k < i; ++k) {
+                    T l = row[k];
+                    const T* u = M.rowData(k);
+                    for (size_t c = rest + cStart; c < rest + cEnd; ++c) {
+                        row[c] -= l * u[c];
+                    }
+                }
+            }
+        }, 256);
+
+        // 4. Trailing update A22 -= L21 x U12 on the GEMM kernel
+        Matrix<T> L21(trailing, jb);
+        Matrix<T> U12(jb, trailing);
+        forEachRowSlab(trailing, [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                std::copy(M.rowData(rest + i) + j0, M.rowData(rest + i) + rest, L21.rowData(i));
+            }
+        });
+        for (size_t k = 0; k < jb; ++k) {
+            std::copy(M.rowData(j0 + k) + rest, M.rowData(j0 + k) + n, U12.rowData(k));
+        }
+        Matrix<T> product = mulMatBlocked(L21, U12);
+        forEachRowSlab(trailing, [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                T* a = M.rowData(rest + i) + rest;
+                const T* p = product.rowData(i);
+                for (size_t c = 0; c < trailing; ++c) {
+                    a[c] -= p[c];
+                }
+            }
+        });
+    }
+    return F;
+}
+
+// Function to solve A X = B given the factorization of A (B may hold several right-hand sides)
+template <typename T>
+Matrix<T> solveLU(LUFactorization<T>& F, Matrix<T>& B) {
+    Matrix<T>& M = F.LU;
+    size_t n = M.numRows();
+    if (B.numRows() != n) {
+        throw std::invalid_argument("Right-hand side has the wrong number of rows");
+    }
+    if (F.singular) {
+        throw std::runtime_error("Matrix is singular");
+    }
+    size_t nrhs = B.numCols();
+    Matrix<T> X = B;
+
+    // Apply the row interchanges in the order they were made
+    for (size_t j = 0; j < n; ++j) {
+        if (F.pivots[j] != j) {
+            std::swap_ranges(X.rowData(j), X.rowData(j) + nrhs, X.rowData(F.pivots[j]));
+        }
+    }
+    // Forward substitution with unit lower L
+    for (size_t i = 1; i < n; ++i) {
+        const T* l = M.rowData(i);
+        T* x = X.rowData(i);
+        for (size_t k = 0; k < i; ++k) {
+            const T* xk = X.rowData(k);
+            for (size_t c = 0; c < nrhs; ++c) {
+                x[c] -= l[k] * xk[c];
+            }
+        }
+    }
+    // Back substitution with U
+    for (size_t i = n; i-- > 0;) {
+        const T* u = M.rowData(i);
+        T* x = X.rowData(i);
+        for (size_t k = i + 1; k < n; ++k) {
+            const T* xk = X.rowData(k);
+            for (size_t c = 0; c < nrhs; ++c) {
+                x[c] -= u[k] * xk[c];
+            }
+        }
+        for (size_t c = 0; c < nrhs; ++c) {
+            x[c] /= u[i];
+        }
+    }
+    return X;
+}
+
+// Function to solve the dense linear system A X = B
+template <typename T>
+Matrix<T> solve(Matrix<T>& A, Matrix<T>& B) {
+    LUFactorization<T> F = factorLU(A);
+    return solveLU(F, B);
+}
@@ -7,26 +7,102 @@
 // and the accompanying helpers.
 //
 
+#include "MatrixBuffer.h" // Contiguous (optionally huge-page) element storage
+#include "MemoryHints.h"  // Prefetch distance and streaming stores for the SIMD kernels
+
 #define size_t unsigned int // Matrix indices = nonnegative integers
 
+// Row-major storage layout (the default)
+struct RowMajor {
+    size_t cols;
+
+    RowMajor(size_t /*rows*/, size_t cols) : cols(cols) {}
+
+    // Number of elements the buffer must hold
+    static unsigned long long storageSize(size_t rows, size_t cols) {
+        return static_cast<unsigned long long>(rows) * cols;
+    }
+
+    // Flat index of (row, col), computed in 64 bits so multi-GB matrices do not wrap
+    unsigned long long index(size_t row, size_t col) const {
+        return static_cast<unsigned long long>(row) * cols + col;
+    }
+};
+
+// Morton (Z-order) tiled storage layout
+//  The matrix is cut into TileSize x TileSize tiles, each stored row-major and contiguous.
+//  Tiles are laid out along a Z-order curve over a square, power-of-two grid (edge tiles
+//  are zero padded), so every quadrant at every level of recursion is contiguous in memory.
+template <size_t TileSize = 32>
+struct MortonTiled {
+    static constexpr size_t tileSize = TileSize;
+    size_t grid; // Edge length of the tile grid, in tiles
+
+    MortonTiled(size_t rows, size_t cols) : grid(tileGrid(rows, cols)) {}
+
+    // Smallest power-of-two tile grid that covers the matrix
+    static size_t tileGrid(size_t rows, size_t cols) {
+        size_t tiles = std::max((rows + TileSize - 1) / TileSize, (cols + TileSize - 1) / TileSize);
+        size_t grid = 1;
+        while (grid < tiles) {
+            grid <<= 1;
+        }
+        return grid;
+    }
+
+    static unsigned long long storageSize(size_t rows, size_t cols) {
+        unsigned long long grid = tileGrid(rows, cols);
+        return grid * grid * TileSize * TileSize;
+    }
+
+    // Spread the low 32 bits of v so there is a zero between each (for bit interleaving)
+    static unsigned long long spreadBits(unsigned long long v) {
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8))  & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2))  & 0x3333333333333333ull;
+        v = (v | (v << 1))  & 0x5555555555555555ull;
+        return v;
+    }
+
+    // Position of tile (tileRow, tileCol) along the Z-order curve
+    static unsigned long long mortonCode(size_t tileRow, size_t tileCol) {
+        return (spreadBits(tileRow) << 1) | spreadBits(tileCol);
+    }
+
+    unsigned long long index(size_t row, size_t col) const {
+        return mortonCode(row / TileSize, col / TileSize) * (TileSize * TileSize)
+             + (row % TileSize) * TileSize + (col % TileSize);
+    }
+};
+
 // Matrix class for compact storing and accessing
-template <typename T>
+template <typename T, typename Layout = RowMajor>
 class Matrix {
 private:
-    std::vector<std::vector<T>> data;
     size_t rows;
     size_t cols;
+    Layout layout;        // Maps (row, col) to an offset in data
+    MatrixBuffer<T> data; // One contiguous allocation
+
+    unsigned long long index(size_t row, size_t col) const {
+        return layout.index(row, col);
+    }
 
 public:
     // Constructor
-    Matrix(size_t rows, size_t cols) : rows(rows), cols(cols) {
-        data.resize(rows, std::vector<T>(cols)); // Allocate only necessary area
-    }
+    Matrix(size_t rows, size_t cols)
+        : rows(rows), cols(cols), layout(rows, cols), data(Layout::storageSize(rows, cols)) {}
+
+    // Constructor for results that are fully overwritten (Uninitialized skips the zero fill) and
+    //  for matrices whose storage comes from a pool (see BufferPolicy)
+    Matrix(size_t rows, size_t cols, BufferInit init, const BufferPolicy& policy = {})
+        : rows(rows), cols(cols), layout(rows, cols), data(Layout::storageSize(rows, cols), init, policy) {}
 
     // Accessor to MODIFY the element at a specific row and column
     T& operator()(size_t row, size_t col) {
         if ((row < rows) && (col < cols)) {
-            return data[row][col];
+            return data[index(row, col)];
         } else {
             throw std::out_of_range("Matrix indices out of range");
         }
@@ -41,11 +117,36 @@ public:
         return cols;
     }
 
+    // Raw pointer to the start of a row (unchecked, for the inner loops of the kernels)
+    T* rowData(size_t row) {
+        static_assert(std::is_same_v<Layout, RowMajor>, "rowData requires row-major storage");
+        return data.data() + index(row, 0);
+    }
+
+    // Raw storage in layout order (for kernels written against a specific layout)
+    T* storage() {
+        return data.data();
+    }
+
+    const Layout& storageLayout() const {
+        return layout;
+    }
+
+    // Allocation policy of the storage (results of kernels on this matrix inherit it)
+    const BufferPolicy& bufferPolicy() const {
+        return data.bufferPolicy();
+    }
+
+    // How the element storage is backed (heap, 4 KB pages, or 2 MB huge pages)
+    PageBacking pageBacking() const {
+        return data.pageBacking();
+    }
+
     // Print the matrix
     void print() {
         for (size_t i = 0; i < rows; ++i) {
             for (size_t j = 0; j < cols; ++j) {
-                std::cout << data[i][j] << ' ';
+                std::cout << data[index(i, j)] << ' ';
             }
             std::cout << '\n';
         }
@@ -62,7 +163,7 @@ Matrix<T> mulMatNAIVE(Matrix<T>& A, Matrix<T>& B) {
         throw std::invalid_argument("Matrix dimensions are incompatible for multiplication");
     }
 
-    Matrix<T> result(rowsA, colsB);
+    Matrix<T> result(rowsA, colsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is written
 
     for (size_t i = 0; i < rowsA; ++i) {
         // printf("row: %d\r", i);
@@ -101,7 +202,7 @@ Matrix<T> mulMatMT(Matrix<T>& A, Matrix<T>& B) {
     size_t numColsB = B.numCols();
 
     // Create a result matrix of appropriate size
-    Matrix<T> result(numRowsA, numColsB);
+    Matrix<T> result(numRowsA, numColsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is written
 
     // Determine the number of threads to use (you can adjust this as needed)
     size_t numThreads = std::thread::hardware_concurrency();
@@ -120,6 +221,29 @@ Matrix<T> mulMatMT(Matrix<T>& A, Matrix<T>& B) {
 
     return result;
 }
+// Function to multiply rows [startRow, endRow) with 8-lane integer SIMD (used for SIMD and MT SIMD)
+template <typename T>
+void mulSIMDRows(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C, size_t startRow, size_t endRow,
+                 size_t distance, bool stream) {
+    for (size_t i = startRow; i < endRow; ++i) {
+        for (size_t j = 0; j < C.numCols(); j += 8) {
+            auto sum = _mm256_setzero_si256();
+            for (size_t k = 0; k < B.numCols(); k++) {
+                if (distance && k + distance < B.numRows()) {
+                    prefetchLine(B.rowData(k + distance) + j); // B is walked down a column strip
+                }
+                auto a = _mm256_set1_epi32(A(i, k));
+                auto b = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&B(k, j)));
+                auto axb = _mm256_mullo_epi32(a, b);
+                sum = _mm256_add_epi32(sum, axb);
+            }
+            storeLanes(reinterpret_cast<__m256i*>(&C(i, j)), sum, stream);
+        }
+    }
+    if (stream) {
+        _mm_sfence(); // Make the non-temporal stores globally visible
+    }
+}
 // Function to perform matrix multiplication using SIMD only
 template <typename T>
 Matrix<T> mulMatSIMD(Matrix<T>& A, Matrix<T>& B) {
@@ -132,21 +256,25 @@ Matrix<T> mulMatSIMD(Matrix<T>& A, Matrix<T>& B) {
 
     size_t rowsA = A.numRows();
     size_t colsB = B.numCols();
-    Matrix<T> C(rowsA, colsB);
-
-    for (size_t i = 0; i < rowsA; ++i) {
-        for (size_t j = 0; j < colsB; j += 8) {
-            auto sum = _mm256_setzero_si256();
-            for (size_t k = 0; k < colsB; k++) {
-                auto a = _mm256_set1_epi32(A(i, k));
-                auto b = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&B(k, j)));
-                auto axb = _mm256_mullo_epi32(a, b);
-                sum = _mm256_add_epi32(sum, axb);
+    Matrix<T> C(rowsA, colsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is stored
+    const MemoryHints& hints = memoryHints(SimdKernel::SIMD);
+    size_t distance = hints.prefetchDistance;
+    bool stream = useStreamingStores(hints, 1ull * rowsA * colsB * sizeof(T), C.storage(), 1ull * colsB * sizeof(T));
+    mulSIMDRows(A, B, C, 0u, rowsA, distance, stream);
+    return C;
+}
+// Function to multiply rows [startRow, endRow) against a transposed B (used for CO and MT CO)
+template <typename T>
+void mulTransposedRows(Matrix<T>& A, Matrix<T>& BTransposed, Matrix<T>& C, size_t startRow, size_t endRow) {
+    for (size_t i = startRow; i < endRow; ++i) {
+        for (size_t j = 0; j < C.numCols(); ++j) {
+            T sum = 0;
+            for (size_t k = 0; k < A.numCols(); ++k) {
+                sum += A(i, k) * BTransposed(j, k);
             }
-            _mm256_storeu_si256((__m256i*)(&C(i, j)), sum);
+            C(i, j) = sum;
         }
     }
-    return C;
 }
 // Function to perform matrix multiplication using cache optimization (transposition) only
 template <typename T>
@@ -158,29 +286,20 @@ Matrix<T> mulMatCO(Matrix<T>& A, Matrix<T>& B) {
     size_t numRowsA = A.numRows();
     size_t numRowsB = B.numRows();
     size_t numColsB = B.numCols();
-    size_t commonDim = A.numCols();
 
     // Transpose matrix B
-    Matrix<T> BTransposed(numColsB, numRowsB);
+    Matrix<T> BTransposed(numColsB, numRowsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is copied below
     for (size_t i = 0; i < numRowsB; ++i) {
         for (size_t j = 0; j < numColsB; ++j) {
             BTransposed(j, i) = B(i, j);
         }
     }
 
-    // Create a result matrix of appropriate size
-    Matrix<T> result(numRowsA, numColsB);
+    // Create a result matrix of appropriate size (each element is assigned once below)
+    Matrix<T> result(numRowsA, numColsB, BufferInit::Uninitialized, A.bufferPolicy());
 
     // Perform matrix multiplication using transposed matrix B
-    for (size_t i = 0; i < numRowsA; ++i) {
-        for (size_t j = 0; j < numColsB; ++j) {
-            T sum = 0;
-            for (size_t k = 0; k < commonDim; ++k) {
-                sum += A(i, k) * BTransposed(j, k);
-            }
-            result(i, j) = sum;
-        }
-    }
+    mulTransposedRows(A, BTransposed, result, 0u, numRowsA);
 
     return result;
 }
@@ -195,7 +314,11 @@ Matrix<T> mulMatMT_SIMD(Matrix<T>& A, Matrix<T>& B) {
     size_t numColsB = B.numCols();
 
     // Create a result matrix of appropriate size
-    Matrix<T> result(numRowsA, numColsB);
+    Matrix<T> result(numRowsA, numColsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is stored
+    const MemoryHints& hints = memoryHints(SimdKernel::MT_SIMD);
+    size_t distance = hints.prefetchDistance;
+    bool stream = useStreamingStores(hints, 1ull * numRowsA * numColsB * sizeof(T), result.storage(),
+                                     1ull * numColsB * sizeof(T));
 
     // Determine the number of threads to use (you can adjust this as needed)
     size_t numThreads = std::thread::hardware_concurrency();
@@ -205,21 +328,9 @@ Matrix<T> mulMatMT_SIMD(Matrix<T>& A, Matrix<T>& B) {
     for (size_t threadID = 0; threadID < numThreads; ++threadID) {
         size_t startRow = (threadID * numRowsA) / numThreads;
         size_t endRow = ((threadID + 1) * numRowsA) / numThreads;
-        threads.emplace_back([&A, &B, &result, startRow, endRow, numColsB] {
-            // Perform SIMD-accelerated multiplication within the thread
-            for (size_t i = startRow; i < endRow; ++i) {
-                for (size_t j = 0; j < numColsB; j += 8) {
-                    auto sum = _mm256_setzero_si256();
-                    for (size_t k = 0; k < B.numCols(); k++) {
-                        auto a = _mm256_set1_epi32(A(i, k));
-                        auto b = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&B(k, j)));
-                        auto axb = _mm256_mullo_epi32(a, b);
-                        sum = _mm256_add_epi32(sum, axb);
-                    }
-                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&result(i, j)), sum);
-                }
-            }
-        });
+        // Perform SIMD-accelerated multiplication within the thread
+        threads.emplace_back(mulSIMDRows<T>, std::ref(A), std::ref(B), std::ref(result), startRow, endRow,
+                             distance, stream);
     }
 
     // Join all the threads
@@ -229,6 +340,45 @@ Matrix<T> mulMatMT_SIMD(Matrix<T>& A, Matrix<T>& B) {
 
     return result;
 }
+// Function to multiply rows [startRow, endRow) against a transposed B with 8-lane integer SIMD
+//  (used for SIMD CO and MAXIMUM). Each C(i, j) is a dot product of row i of A with row j of B^T,
+//  8 products per instruction along k; eight finished dot products are stored together.
+template <typename T>
+void mulTransposedSIMDRows(Matrix<T>& A, Matrix<T>& BTransposed, Matrix<T>& C, size_t startRow, size_t endRow,
+                           size_t distance, bool stream) {
+    size_t commonDim = BTransposed.numCols();
+    alignas(32) int dots[8];
+    for (size_t i = startRow; i < endRow; ++i) {
+        const int* a = reinterpret_cast<const int*>(A.rowData(i));
+        for (size_t j = 0; j < C.numCols(); j += 8) {
+            for (size_t lane = 0; lane < 8; ++lane) {
+                const int* b = reinterpret_cast<const int*>(BTransposed.rowData(j + lane));
+                auto sum = _mm256_setzero_si256();
+                size_t k = 0;
+                for (; k + 8 <= commonDim; k += 8) {
+                    if (distance && k + distance < commonDim) {
+                        prefetchLine(b + k + distance); // Row j of B^T is read sequentially
+                    }
+                    auto av = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+                    auto bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+                    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(av, bv));
+                }
+                __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+                half = _mm_hadd_epi32(half, half);
+                half = _mm_hadd_epi32(half, half);
+                int dot = _mm_cvtsi128_si32(half);
+                for (; k < commonDim; ++k) {
+                    dot += a[k] * b[k];
+                }
+                dots[lane] = dot;
+            }
+            storeLanes(reinterpret_cast<__m256i*>(&C(i, j)), _mm256_load_si256(reinterpret_cast<const __m256i*>(dots)), stream);
+        }
+    }
+    if (stream) {
+        _mm_sfence();
+    }
+}
 // Function to perform matrix multiplication using cache optimization and SIMD
 template <typename T>
 Matrix<T> mulMatSIMD_CO(Matrix<T>& A, Matrix<T>& B) {
@@ -241,7 +391,7 @@ Matrix<T> mulMatSIMD_CO(Matrix<T>& A, Matrix<T>& B) {
     size_t numColsB = B.numCols();
 
     // Transpose matrix B
-    Matrix<T> BTransposed(numColsB, numRowsB);
+    Matrix<T> BTransposed(numColsB, numRowsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is copied below
     for (size_t i = 0; i < numRowsB; ++i) {
         for (size_t j = 0; j < numColsB; ++j) {
             BTransposed(j, i) = B(i, j);
@@ -249,21 +399,14 @@ Matrix<T> mulMatSIMD_CO(Matrix<T>& A, Matrix<T>& B) {
     }
 
     // Create a result matrix of appropriate size
-    Matrix<T> result(numRowsA, numColsB);
+    Matrix<T> result(numRowsA, numColsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is stored
+    const MemoryHints& hints = memoryHints(SimdKernel::SIMD_CO);
+    size_t distance = hints.prefetchDistance;
+    bool stream = useStreamingStores(hints, 1ull * numRowsA * numColsB * sizeof(T), result.storage(),
+                                     1ull * numColsB * sizeof(T));
 
     // Perform matrix multiplication with SIMD using the transposed matrix B
-    for (size_t i = 0; i < numRowsA; ++i) {
-        for (size_t j = 0; j < numColsB; j += 8) {
-            auto sum = _mm256_setzero_si256();
-            for (size_t k = 0; k < BTransposed.numCols(); k++) {
-                auto a = _mm256_set1_epi32(A(i, k));
-                auto b = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&BTransposed(j, k)));
-                auto axb = _mm256_mullo_epi32(a, b);
-                sum = _mm256_add_epi32(sum, axb);
-            }
-            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&result(i, j)), sum);
-        }
-    }
+    mulTransposedSIMDRows(A, BTransposed, result, 0u, numRowsA, distance, stream);
 
     return result;
 }
@@ -279,10 +422,10 @@ Matrix<T> mulMatMT_CO(Matrix<T>& A, Matrix<T>& B) {
     size_t numColsB = B.numCols();
 
     // Create a result matrix of appropriate size
-    Matrix<T> result(numRowsA, numColsB);
+    Matrix<T> result(numRowsA, numColsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is written
 
     // Transpose matrix B
-    Matrix<T> BTransposed(numColsB, numRowsB);
+    Matrix<T> BTransposed(numColsB, numRowsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is copied below
     for (size_t i = 0; i < numRowsB; ++i) {
         for (size_t j = 0; j < numColsB; ++j) {
             BTransposed(j, i) = B(i, j);
@@ -297,18 +440,9 @@ Matrix<T> mulMatMT_CO(Matrix<T>& A, Matrix<T>& B) {
     for (size_t threadID = 0; threadID < numThreads; ++threadID) {
         size_t startRow = (threadID * numRowsA) / numThreads;
         size_t endRow = ((threadID + 1) * numRowsA) / numThreads;
-        threads.emplace_back([&A, &BTransposed, &result, startRow, endRow, numColsB] {
-            // Perform cache-optimized multiplication within the thread
-            for (size_t i = startRow; i < endRow; ++i) {
-                for (size_t j = 0; j < numColsB; ++j) {
-                    T sum = 0;
-                    for (size_t k = 0; k < A.numCols(); ++k) {
-                        sum += A(i, k) * BTransposed(j, k);
-                    }
-                    result(i, j) = sum;
-                }
-            }
-        });
+        // Perform cache-optimized multiplication within the thread
+        threads.emplace_back(mulTransposedRows<T>, std::ref(A), std::ref(BTransposed), std::ref(result),
+                             startRow, endRow);
     }
 
     // Join all the threads
@@ -330,7 +464,7 @@ Matrix<T> mulMatMAXIMUM(Matrix<T>& A, Matrix<T>& B) {
     size_t numColsB = B.numCols();
 
     // Transpose matrix B
-    Matrix<T> BTransposed(numColsB, numRowsB);
+    Matrix<T> BTransposed(numColsB, numRowsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is copied below
     for (size_t i = 0; i < numRowsB; ++i) {
         for (size_t j = 0; j < numColsB; ++j) {
             BTransposed(j, i) = B(i, j);
@@ -338,7 +472,11 @@ Matrix<T> mulMatMAXIMUM(Matrix<T>& A, Matrix<T>& B) {
     }
 
     // Create a result matrix of appropriate size
-    Matrix<T> result(numRowsA, numColsB);
+    Matrix<T> result(numRowsA, numColsB, BufferInit::Uninitialized, A.bufferPolicy()); // Every element is stored
+    const MemoryHints& hints = memoryHints(SimdKernel::MAXIMUM);
+    size_t distance = hints.prefetchDistance;
+    bool stream = useStreamingStores(hints, 1ull * numRowsA * numColsB * sizeof(T), result.storage(),
+                                     1ull * numColsB * sizeof(T));
 
     // Determine the number of threads to use (you can adjust this as needed)
     size_t numThreads = std::thread::hardware_concurrency();
@@ -348,27 +486,215 @@ Matrix<T> mulMatMAXIMUM(Matrix<T>& A, Matrix<T>& B) {
     for (size_t threadID = 0; threadID < numThreads; ++threadID) {
         size_t startRow = (threadID * numRowsA) / numThreads;
         size_t endRow = ((threadID + 1) * numRowsA) / numThreads;
-        threads.emplace_back([&A, &BTransposed, &result, startRow, endRow, numColsB] {
-            // Perform multithreaded SIMD-accelerated cache-optimized multiplication within the thread
+        // Perform multithreaded SIMD-accelerated cache-optimized multiplication within the thread
+        threads.emplace_back(mulTransposedSIMDRows<T>, std::ref(A), std::ref(BTransposed), std::ref(result),
+                             startRow, endRow, distance, stream);
+    }
+
+    // Join all the threads
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return result;
+}
+// Helper to run body(startRow, endRow) over numRows rows split across hardware threads
+template <typename F>
+void forEachRowSlab(size_t numRows, F body, size_t minRowsPerThread = 64) {
+    size_t numThreads = std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                              numRows / std::max(1u, minRowsPerThread)));
+    if (numThreads <= 1) {
+        body(0u, numRows);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t threadID = 0; threadID < numThreads; ++threadID) {
+        size_t startRow = (threadID * numRows) / numThreads;
+        size_t endRow = ((threadID + 1) * numRows) / numThreads;
+        threads.emplace_back(body, startRow, endRow);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+// Everything on the calling thread
+struct SequentialExecution {
+    static constexpr const char* name = "sequential";
+};
+// One std::thread per slab of rows (forEachRowSlab)
+struct ThreadSplitExecution {
+    static constexpr const char* name = "std::thread slabs";
+    size_t minRowsPerThread = 16;
+};
+// Helper to run body(startRow, endRow) over [0, numRows) under the given policy (more in ExecutionPolicy.h)
+template <typename F>
+void forEachRowBlock(const SequentialExecution&, size_t numRows, F body) {
+    body(0u, numRows);
+}
+template <typename F>
+void forEachRowBlock(const ThreadSplitExecution& policy, size_t numRows, F body) {
+    forEachRowSlab(numRows, body, policy.minRowsPerThread);
+}
+// Function to accumulate rows [startRow, endRow) of C += A x B using cache blocking (i-k-j order)
+template <typename T>
+void mulAddBlockedRows(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C, size_t startRow, size_t endRow) {
+    size_t numColsB = B.numCols();
+    size_t commonDim = A.numCols();
+    const size_t blockSize = 128; // 128 x 128 block of B (64 KB for 4-byte T) stays cache resident
+
+    // Walk B one block at a time so it is reused by every row of the slab
+    for (size_t kk = 0; kk < commonDim; kk += blockSize) {
+        size_t kEnd = std::min(kk + blockSize, commonDim);
+        for (size_t jj = 0; jj < numColsB; jj += blockSize) {
+            size_t jEnd = std::min(jj + blockSize, numColsB);
             for (size_t i = startRow; i < endRow; ++i) {
-                for (size_t j = 0; j < numColsB; j += 8) {
-                    auto sum = _mm256_setzero_si256();
-                    for (size_t k = 0; k < BTransposed.numCols(); k++) {
-                        auto a = _mm256_set1_epi32(A(i, k));
-                        auto b = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&BTransposed(j, k)));
-                        auto axb = _mm256_mullo_epi32(a, b);
-                        sum = _mm256_add_epi32(sum, axb);
+                T* a = A.rowData(i);
+                T* c = C.rowData(i);
+                for (size_t k = kk; k < kEnd; ++k) {
+                    T aik = a[k];
+                    T* b = B.rowData(k);
+                    // Contiguous in both b and c, so the compiler vectorizes this loop
+                    for (size_t j = jj; j < jEnd; ++j) {
+                        c[j] += aik * b[j];
                     }
-                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&result(i, j)), sum);
                 }
             }
-        });
+        }
+    }
+}
+// Function to accumulate C += A x B using cache blocking and MT (row slabs)
+template <typename T>
+void mulAddBlocked(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C) {
+    if (A.numCols() != B.numRows() || A.numRows() != C.numRows() || B.numCols() != C.numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+
+    size_t numRowsA = A.numRows();
+
+    // Determine the number of threads to use (you can adjust this as needed)
+    size_t numThreads = std::thread::hardware_concurrency();
+
+    // Divide the work among threads
+    std::vector<std::thread> threads;
+    for (size_t threadID = 0; threadID < numThreads; ++threadID) {
+        size_t startRow = (threadID * numRowsA) / numThreads;
+        size_t endRow = ((threadID + 1) * numRowsA) / numThreads;
+        threads.emplace_back(mulAddBlockedRows<T>, std::ref(A), std::ref(B), std::ref(C), startRow, endRow);
     }
 
     // Join all the threads
     for (auto& thread : threads) {
         thread.join();
     }
+}
+// Function to perform matrix multiplication using cache blocking and MT (valid for any T and shape)
+template <typename T>
+Matrix<T> mulMatBlocked(Matrix<T>& A, Matrix<T>& B) {
+    Matrix<T> result(A.numRows(), B.numCols(), BufferInit::Zero, A.bufferPolicy()); // Accumulated into
+    mulAddBlocked(A, B, result);
+    return result;
+}
+// Function to convert a row-major matrix to the Morton tiled layout
+template <size_t TileSize, typename T>
+Matrix<T, MortonTiled<TileSize>> toMorton(Matrix<T>& A) {
+    Matrix<T, MortonTiled<TileSize>> result(A.numRows(), A.numCols(), BufferInit::Zero, A.bufferPolicy());
+    // Copy tile by tile, one contiguous tile row at a time (padding stays zero)
+    for (size_t tr = 0; tr * TileSize < A.numRows(); ++tr) {
+        for (size_t tc = 0; tc * TileSize < A.numCols(); ++tc) {
+            T* tile = result.storage() + MortonTiled<TileSize>::mortonCode(tr, tc) * (TileSize * TileSize);
+            size_t h = std::min(TileSize, A.numRows() - tr * TileSize);
+            size_t w = std::min(TileSize, A.numCols() - tc * TileSize);
+            for (size_t r = 0; r < h; ++r) {
+                std::copy(A.rowData(tr * TileSize + r) + tc * TileSize,
+                          A.rowData(tr * TileSize + r) + tc * TileSize + w, tile + r * TileSize);
+            }
+        }
+    }
+    return result;
+}
+// Function to convert a Morton tiled matrix back to row-major
+template <size_t TileSize, typename T>
+Matrix<T> toRowMajor(Matrix<T, MortonTiled<TileSize>>& A) {
+    Matrix<T> result(A.numRows(), A.numCols(), BufferInit::Uninitialized, A.bufferPolicy()); // Every tile is copied out
+    for (size_t tr = 0; tr * TileSize < A.numRows(); ++tr) {
+        for (size_t tc = 0; tc * TileSize < A.numCols(); ++tc) {
+            T* tile = A.storage() + MortonTiled<TileSize>::mortonCode(tr, tc) * (TileSize * TileSize);
+            size_t h = std::min(TileSize, A.numRows() - tr * TileSize);
+            size_t w = std::min(TileSize, A.numCols() - tc * TileSize);
+            for (size_t r = 0; r < h; ++r) {
+                std::copy(tile + r * TileSize, tile + r * TileSize + w,
+                          result.rowData(tr * TileSize + r) + tc * TileSize);
+            }
+        }
+    }
+    return result;
+}
+// Recursive helper: C += A x B for three contiguous Morton quadrants that are tiles x tiles tiles
+template <size_t TileSize, typename T>
+void mulAddMortonRecursive(const T* A, const T* B, T* C, size_t tiles, size_t parallelDepth) {
+    if (tiles == 1) {
+        // Base case: one tile of each, all three resident in L1 (i-k-j order, vectorizable)
+        for (size_t i = 0; i < TileSize; ++i) {
+            T* c = C + i * TileSize;
+            for (size_t k = 0; k < TileSize; ++k) {
+                T aik = A[i * TileSize + k];
+                const T* b = B + k * TileSize;
+                for (size_t j = 0; j < TileSize; ++j) {
+                    c[j] += aik * b[j];
+                }
+            }
+        }
+        return;
+    }
 
+    // Quadrants 0..3 are (0,0) (0,1) (1,0) (1,1) and each occupies a quarter of the block
+    size_t half = tiles / 2;
+    unsigned long long q = static_cast<unsigned long long>(half) * half * TileSize * TileSize;
+    const T* A00 = A; const T* A01 = A + q; const T* A10 = A + 2 * q; const T* A11 = A + 3 * q;
+    const T* B00 = B; const T* B01 = B + q; const T* B10 = B + 2 * q; const T* B11 = B + 3 * q;
+    T* C00 = C; T* C01 = C + q; T* C10 = C + 2 * q; T* C11 = C + 3 * q;
+
+    // Each C quadrant receives two products; the four quadrants are independent
+    auto quadrant = [half, parallelDepth](const T* X0, const T* Y0, const T* X1, const T* Y1, T* Z) {
+        size_t nextDepth = parallelDepth > 0 ? parallelDepth - 1 : 0;
+        mulAddMortonRecursive<TileSize>(X0, Y0, Z, half, nextDepth);
+        mulAddMortonRecursive<TileSize>(X1, Y1, Z, half, nextDepth);
+    };
+    if (parallelDepth > 0) {
+        std::vector<std::thread> threads;
+        threads.reserve(3);
+        threads.emplace_back(quadrant, A00, B00, A01, B10, C00);
+        threads.emplace_back(quadrant, A00, B01, A01, B11, C01);
+        threads.emplace_back(quadrant, A10, B00, A11, B10, C10);
+        quadrant(A10, B01, A11, B11, C11);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    } else {
+        quadrant(A00, B00, A01, B10, C00);
+        quadrant(A00, B01, A01, B11, C01);
+        quadrant(A10, B00, A11, B10, C10);
+        quadrant(A10, B01, A11, B11, C11);
+    }
+}
+// Function to perform cache-oblivious recursive matrix multiplication on the Morton layout
+template <size_t TileSize, typename T>
+Matrix<T, MortonTiled<TileSize>> mulMatMorton(Matrix<T, MortonTiled<TileSize>>& A, Matrix<T, MortonTiled<TileSize>>& B) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T, MortonTiled<TileSize>> result(A.numRows(), B.numCols());
+    size_t grid = A.storageLayout().grid;
+    if (B.storageLayout().grid != grid || result.storageLayout().grid != grid) {
+        throw std::invalid_argument("Morton multiplication requires operands with the same tile grid");
+    }
+
+    // Fork at the top levels until there are at least as many quadrant tasks as hardware threads
+    size_t parallelDepth = 0;
+    for (size_t tasks = 1; tasks < std::thread::hardware_concurrency() && (grid >> parallelDepth) > 1; tasks *= 4) {
+        ++parallelDepth;
+    }
+    mulAddMortonRecursive<TileSize>(A.storage(), B.storage(), result.storage(), grid, parallelDepth);
     return result;
-}
\ No newline at end of file
+}
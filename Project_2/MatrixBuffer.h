@@ -0,0 +1,380 @@
+//
+// file: MatrixBuffer.h
+// desc: ACS Project 2 Matrix Storage Header
+// auth: Andrew Prata
+//
+// This header file contains the contiguous element
+// buffer behind the Matrix class. Buffers above a size
+// threshold are mapped directly from the OS so they can
+// be backed by 2 MB huge pages (hugetlbfs first, then
+// transparent huge pages via madvise). A buffer can be
+// given a pool that keeps released blocks for reuse, so
+// repeated kernel calls stop paying for fresh,
+// page-faulting memory.
+//
+
+#pragma once
+
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uintptr_t
+#include <cstring>   // std::memcpy/std::memset
+#include <new>       // ::operator new(std::align_val_t)
+#include <algorithm> // std::fill
+#include <utility>   // std::swap
+#include <atomic>    // Allocation counters
+#include <map>       // Pool free lists by size class
+#include <mutex>     // Pool lock
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>     // mmap/madvise/munmap
+#include <sys/resource.h> // getrusage (page fault counts)
+#endif
+
+// Process-wide policy for how large matrix buffers are backed
+struct HugePagePolicy {
+    static inline bool enabled = true;                     // false = force 4 KB pages (for comparison)
+    static inline std::size_t thresholdBytes = 2u << 20;   // Buffers at least this large are mmap'd
+    static constexpr std::size_t hugePageBytes = 2u << 20; // x86-64 huge page size
+};
+
+// How a particular buffer ended up being backed
+enum class PageBacking { Heap, SmallPages, TransparentHuge, HugeTLB };
+
+inline const char* pageBackingName(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::Heap:            return "heap";
+        case PageBacking::SmallPages:      return "mmap, 4 KB pages";
+        case PageBacking::TransparentHuge: return "mmap, 2 MB transparent huge pages";
+        case PageBacking::HugeTLB:         return "mmap, 2 MB hugetlbfs pages";
+    }
+    return "unknown";
+}
+
+// Whether a new buffer must read as zeros
+enum class BufferInit { Zero, Uninitialized };
+
+// One raw allocation, as handed out by the OS/heap or by the pool
+struct MemoryBlock {
+    void* ptr = nullptr;
+    std::size_t capacity = 0;    // Usable bytes
+    std::size_t mappedBytes = 0; // Nonzero when the memory came from mmap
+    PageBacking backing = PageBacking::Heap;
+    bool clean = false;          // Known to read as zeros
+};
+
+// Process-wide allocation counters (read through AllocationScope)
+struct AllocationCounters {
+    static inline std::atomic<unsigned long long> allocations{0};
+    static inline std::atomic<unsigned long long> bytesRequested{0};
+    static inline std::atomic<unsigned long long> bytesFresh{0};  // New memory from the OS or heap
+    static inline std::atomic<unsigned long long> poolHits{0};    // Requests served by a recycled block
+    static inline std::atomic<unsigned long long> bytesZeroed{0}; // Bytes explicitly cleared
+};
+
+// Function to get a 64-byte aligned block of at least `bytes` (always reads as zeros)
+inline MemoryBlock allocateBlock(std::size_t bytes) {
+    MemoryBlock block;
+    block.capacity = bytes;
+    if (bytes == 0) {
+        return block;
+    }
+    AllocationCounters::bytesFresh += bytes;
+#ifdef __linux__
+    if (bytes >= HugePagePolicy::thresholdBytes) {
+        const std::size_t huge = HugePagePolicy::hugePageBytes;
+        std::size_t mapped = (bytes + huge - 1) / huge * huge;
+        // Preferred: explicit hugetlbfs pages (only succeeds if the admin reserved some)
+        if (HugePagePolicy::enabled) {
+            void* p = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                return {p, mapped, mapped, PageBacking::HugeTLB, true};
+            }
+        }
+        // Fallback: over-map by one huge page and trim so the region is 2 MB aligned
+        void* raw = mmap(nullptr, mapped + huge, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            char* base = static_cast<char*>(raw);
+            char* aligned = reinterpret_cast<char*>(
+                (reinterpret_cast<std::uintptr_t>(base) + huge - 1) & ~(std::uintptr_t)(huge - 1));
+            if (aligned != base) {
+                munmap(base, aligned - base);
+            }
+            munmap(aligned + mapped, (base + mapped + huge) - (aligned + mapped));
+            PageBacking backing = PageBacking::SmallPages;
+            if (HugePagePolicy::enabled && madvise(aligned, mapped, MADV_HUGEPAGE) == 0) {
+                backing = PageBacking::TransparentHuge;
+            } else {
+                madvise(aligned, mapped, MADV_NOHUGEPAGE); // Honest 4 KB baseline even if THP=always
+            }
+            return {aligned, mapped, mapped, backing, true}; // Anonymous mappings are zero-filled
+        }
+    }
+#endif
+    block.ptr = ::operator new(bytes, std::align_val_t(64));
+    return block; // Heap memory is not clean
+}
+
+// Function to give a block back to the OS/heap
+inline void releaseBlock(MemoryBlock& block) {
+    if (block.ptr != nullptr) {
+#ifdef __linux__
+        if (block.mappedBytes != 0) {
+            munmap(block.ptr, block.mappedBytes);
+        } else
+#endif
+        {
+            ::operator delete(block.ptr, std::align_val_t(64));
+        }
+    }
+    block = MemoryBlock{};
+}
+
+// Recycling pool for matrix buffers (used by buffers whose BufferPolicy names it)
+//  Released blocks are kept on a free list per size class instead of being returned to the OS,
+//  so their pages stay faulted in. reserve() pre-faults blocks before a timed run. A pool must
+//  outlive every buffer allocated from it.
+class MatrixPool {
+private:
+    std::mutex poolMutex;
+    std::map<std::size_t, std::vector<MemoryBlock>> freeLists; // Size class -> cached blocks
+    std::size_t cachedBytes = 0;
+
+public:
+    MatrixPool() = default;
+
+    ~MatrixPool() {
+        trim();
+    }
+
+    MatrixPool(const MatrixPool&) = delete;
+    MatrixPool& operator=(const MatrixPool&) = delete;
+
+    // Requests are rounded up to a power of two below 2 MB and to whole huge pages above it
+    static std::size_t sizeClass(std::size_t bytes) {
+        if (bytes >= HugePagePolicy::hugePageBytes) {
+            return (bytes + HugePagePolicy::hugePageBytes - 1) / HugePagePolicy::hugePageBytes *
+                   HugePagePolicy::hugePageBytes;
+        }
+        std::size_t size = 64;
+        while (size < bytes) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    // Take a block of at least `bytes` (recycled when possible)
+    MemoryBlock acquire(std::size_t bytes) {
+        std::size_t size = sizeClass(bytes);
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            auto it = freeLists.find(size);
+            if (it != freeLists.end() && !it->second.empty()) {
+                MemoryBlock block = it->second.back();
+                it->second.pop_back();
+                cachedBytes -= block.capacity;
+                ++AllocationCounters::poolHits;
+                return block;
+            }
+        }
+        return allocateBlock(size);
+    }
+
+    // Keep a block for reuse (its contents are now stale)
+    void recycle(MemoryBlock block) {
+        block.clean = false;
+        std::lock_guard<std::mutex> lock(poolMutex);
+        cachedBytes += block.capacity;
+        freeLists[sizeClass(block.capacity)].push_back(block);
+    }
+
+    // Pre-fault `count` blocks big enough for `bytes` each (touches every page, leaves them zero)
+    void reserve(std::size_t bytes, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            MemoryBlock block = allocateBlock(sizeClass(bytes));
+            std::memset(block.ptr, 0, block.capacity);
+            block.clean = true;
+            std::lock_guard<std::mutex> lock(poolMutex);
+            cachedBytes += block.capacity;
+            freeLists[block.capacity].push_back(block);
+        }
+    }
+
+    // Return every cached block to the OS/heap
+    void trim() {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        for (auto& entry : freeLists) {
+            for (MemoryBlock& block : entry.second) {
+                releaseBlock(block);
+            }
+        }
+        freeLists.clear();
+        cachedBytes = 0;
+    }
+
+    std::size_t bytesCached() {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        return cachedBytes;
+    }
+};
+
+// How a buffer gets its memory: from a pool or fresh, and whether Uninitialized may skip the zero fill
+//  The default (no pool, zero fill skipped) is the plain allocation path. Kernels allocate results
+//  and scratch copies under the policy of their first operand, so the policy follows the data.
+struct BufferPolicy {
+    MatrixPool* pool = nullptr; // Recycle blocks through this pool (nullptr = fresh memory)
+    bool skipZeroFill = true;   // false = zero every buffer, even Uninitialized ones (for comparison)
+};
+
+// Allocation activity between construction and report() (page faults are process wide)
+struct AllocationReport {
+    unsigned long long allocations = 0;
+    unsigned long long bytesRequested = 0;
+    unsigned long long bytesFresh = 0;
+    unsigned long long poolHits = 0;
+    unsigned long long bytesZeroed = 0;
+    long long minorFaults = -1; // -1 when getrusage is unavailable
+    long long majorFaults = -1;
+};
+
+class AllocationScope {
+private:
+    AllocationReport start;
+
+    static AllocationReport snapshot() {
+        AllocationReport now;
+        now.allocations = AllocationCounters::allocations;
+        now.bytesRequested = AllocationCounters::bytesRequested;
+        now.bytesFresh = AllocationCounters::bytesFresh;
+        now.poolHits = AllocationCounters::poolHits;
+        now.bytesZeroed = AllocationCounters::bytesZeroed;
+#ifdef __linux__
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            now.minorFaults = usage.ru_minflt;
+            now.majorFaults = usage.ru_majflt;
+        }
+#endif
+        return now;
+    }
+
+public:
+    AllocationScope() : start(snapshot()) {}
+
+    AllocationReport report() const {
+        AllocationReport now = snapshot();
+        now.allocations -= start.allocations;
+        now.bytesRequested -= start.bytesRequested;
+        now.bytesFresh -= start.bytesFresh;
+        now.poolHits -= start.poolHits;
+        now.bytesZeroed -= start.bytesZeroed;
+        if (start.minorFaults >= 0 && now.minorFaults >= 0) {
+            now.minorFaults -= start.minorFaults;
+            now.majorFaults -= start.majorFaults;
+        }
+        return now;
+    }
+};
+
+// Owning, 64-byte aligned array of T (zero-initialized unless BufferInit::Uninitialized)
+template <typename T>
+class MatrixBuffer {
+private:
+    T* ptr = nullptr;
+    std::size_t count = 0;
+    MemoryBlock block;
+    BufferPolicy policy; // Where the block came from (and goes back to)
+
+    void allocate(std::size_t n, BufferInit init) {
+        count = n;
+        std::size_t bytes = n * sizeof(T);
+        if (bytes == 0) {
+            return;
+        }
+        ++AllocationCounters::allocations;
+        AllocationCounters::bytesRequested += bytes;
+        block = (policy.pool != nullptr) ? policy.pool->acquire(bytes) : allocateBlock(bytes);
+        ptr = static_cast<T*>(block.ptr);
+        if ((init == BufferInit::Zero || !policy.skipZeroFill) && !block.clean) {
+            std::fill(ptr, ptr + n, T(0));
+            AllocationCounters::bytesZeroed += bytes;
+        }
+    }
+
+    void release() {
+        if (block.ptr != nullptr) {
+            if (policy.pool != nullptr) {
+                policy.pool->recycle(block);
+                block = MemoryBlock{};
+            } else {
+                releaseBlock(block);
+            }
+        }
+        ptr = nullptr;
+        count = 0;
+    }
+
+public:
+    MatrixBuffer() = default;
+
+    explicit MatrixBuffer(std::size_t n, BufferInit init = BufferInit::Zero, const BufferPolicy& policy = {})
+        : policy(policy) {
+        allocate(n, init);
+    }
+
+    MatrixBuffer(const MatrixBuffer& other) : policy(other.policy) {
+        allocate(other.count, BufferInit::Uninitialized); // Overwritten by the copy below
+        if (count != 0) {
+            std::memcpy(ptr, other.ptr, count * sizeof(T));
+        }
+    }
+
+    MatrixBuffer(MatrixBuffer&& other) noexcept {
+        swap(other);
+    }
+
+    MatrixBuffer& operator=(MatrixBuffer other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~MatrixBuffer() {
+        release();
+    }
+
+    void swap(MatrixBuffer& other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(count, other.count);
+        std::swap(block, other.block);
+        std::swap(policy, other.policy);
+    }
+
+    T& operator[](std::size_t i) {
+        return ptr[i];
+    }
+
+    const T& operator[](std::size_t i) const {
+        return ptr[i];
+    }
+
+    T* data() {
+        return ptr;
+    }
+
+    const T* data() const {
+        return ptr;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    PageBacking pageBacking() const {
+        return block.backing;
+    }
+
+    const BufferPolicy& bufferPolicy() const {
+        return policy;
+    }
+};
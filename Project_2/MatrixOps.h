@@ -0,0 +1,371 @@
+//
+// file: MatrixOps.h
+// desc: ACS Project 2 Elementwise Operations Header
+// auth: Andrew Prata
+//
+// This header file contains the elementwise operations
+// (add, scale, Hadamard product) and reductions (row
+// sums, column sums, norms) on matrices. They do almost
+// no arithmetic per byte, so the goal is to run at
+// memory bandwidth: AVX2 lanes for int and float, row
+// slabs across threads, and a scalar fallback for
+// other element types. Include it after Matrix.h.
+//
+
+// AVX2 lane operations for the element types that have them
+template <typename T>
+struct SimdLanes {
+    static constexpr bool available = false;
+};
+
+template <>
+struct SimdLanes<int> {
+    static constexpr bool available = true;
+    using Vec = __m256i;
+    static Vec zero() { return _mm256_setzero_si256(); }
+    static Vec set1(int x) { return _mm256_set1_epi32(x); }
+    static Vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(int* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mullo_epi32(a, b); }
+    static Vec mulAdd(Vec a, Vec b, Vec c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+    // Magnitudes are kept as unsigned lanes: |INT_MIN| = 2^31 does not fit an int (abs leaves it 0x80000000)
+    static Vec absMax(Vec m, Vec v) { return _mm256_max_epu32(m, _mm256_abs_epi32(v)); }
+    static __m256d lowToDouble(Vec v) { return _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)); }
+    static __m256d highToDouble(Vec v) { return _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)); }
+    static int sum(Vec v) {
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        s = _mm_hadd_epi32(s, s);
+        s = _mm_hadd_epi32(s, s);
+        return _mm_cvtsi128_si32(s);
+    }
+    static double maxMagnitude(Vec v) {
+        alignas(32) unsigned int lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+        return *std::max_element(lanes, lanes + 8);
+    }
+};
+
+template <>
+struct SimdLanes<float> {
+    static constexpr bool available = true;
+    using Vec = __m256;
+    static Vec zero() { return _mm256_setzero_ps(); }
+    static Vec set1(float x) { return _mm256_set1_ps(x); }
+    static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    static Vec mulAdd(Vec a, Vec b, Vec c) { return _mm256_fmadd_ps(a, b, c); }
+    static Vec absMax(Vec m, Vec v) { return _mm256_max_ps(m, _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v)); }
+    static __m256d lowToDouble(Vec v) { return _mm256_cvtps_pd(_mm256_castps256_ps128(v)); }
+    static __m256d highToDouble(Vec v) { return _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)); }
+    static float sum(Vec v) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        s = _mm_hadd_ps(s, s);
+        s = _mm_hadd_ps(s, s);
+        return _mm_cvtss_f32(s);
+    }
+    static double maxMagnitude(Vec v) {
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, v);
+        return *std::max_element(lanes, lanes + 8);
+    }
+};
+
+// Helper to horizontally add the four doubles of an AVX register
+inline double sumDoubles(__m256d v) {
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+// Helper to apply out[i] = op(a[i], b[i]) over whole matrices, by row blocks under an execution policy
+//  vecOp works on SimdLanes<T> registers (unused, may be nullptr, when T has no lanes); scalarOp on elements.
+//  The default policy is the std::thread row slabs; ExecutionPolicy.h adds the others.
+template <typename T, typename VecOp, typename ScalarOp, typename Policy = ThreadSplitExecution>
+Matrix<T> elementwise(Matrix<T>& A, Matrix<T>& B, VecOp vecOp, ScalarOp scalarOp, const Policy& policy = {}) {
+    if (A.numRows() != B.numRows() || A.numCols() != B.numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for elementwise operation");
+    }
+    Matrix<T> result(A.numRows(), A.numCols(), BufferInit::Uninitialized, A.bufferPolicy()); // Every element is written
+    size_t cols = A.numCols();
+    forEachRowBlock(policy, A.numRows(), [&](size_t startRow, size_t endRow) {
+        // Row-major storage is contiguous, so a block of rows is one flat range
+        const T* a = A.rowData(startRow);
+        const T* b = B.rowData(startRow);
+        T* out = result.rowData(startRow);
+        unsigned long long count = 1ull * (endRow - startRow) * cols;
+        unsigned long long i = 0;
+        if constexpr (SimdLanes<T>::available) {
+            using L = SimdLanes<T>;
+            for (; i + 16 <= count; i += 16) { // Two registers per step to keep two loads in flight
+                L::store(out + i, vecOp(L::load(a + i), L::load(b + i)));
+                L::store(out + i + 8, vecOp(L::load(a + i + 8), L::load(b + i + 8)));
+            }
+            for (; i + 8 <= count; i += 8) {
+                L::store(out + i, vecOp(L::load(a + i), L::load(b + i)));
+            }
+        }
+        for (; i < count; ++i) {
+            out[i] = scalarOp(a[i], b[i]);
+        }
+    });
+    return result;
+}
+
+// Function to add two matrices elementwise (C = A + B)
+template <typename T, typename Policy = ThreadSplitExecution>
+Matrix<T> addMat(Matrix<T>& A, Matrix<T>& B, const Policy& policy = {}) {
+    if constexpr (SimdLanes<T>::available) {
+        return elementwise(A, B,
+            [](auto a, auto b) { return SimdLanes<T>::add(a, b); },
+            [](T a, T b) { return a + b; }, policy);
+    } else {
+        return elementwise(A, B, nullptr, [](T a, T b) { return a + b; }, policy);
+    }
+}
+
+// Function to multiply two matrices elementwise (Hadamard product C = A o B)
+template <typename T, typename Policy = ThreadSplitExecution>
+Matrix<T> hadamardMat(Matrix<T>& A, Matrix<T>& B, const Policy& policy = {}) {
+    if constexpr (SimdLanes<T>::available) {
+        return elementwise(A, B,
+            [](auto a, auto b) { return SimdLanes<T>::mul(a, b); },
+            [](T a, T b) { return a * b; }, policy);
+    } else {
+        return elementwise(A, B, nullptr, [](T a, T b) { return a * b; }, policy);
+    }
+}
+
+// Function to scale a matrix by a constant (C = alpha * A)
+template <typename T, typename Policy = ThreadSplitExecution>
+Matrix<T> scaleMat(Matrix<T>& A, T alpha, const Policy& policy = {}) {
+    if constexpr (SimdLanes<T>::available) {
+        auto alphaVec = SimdLanes<T>::set1(alpha);
+        return elementwise(A, A,
+            [alphaVec](auto a, auto) { return SimdLanes<T>::mul(a, alphaVec); },
+            [alpha](T a, T) { return alpha * a; }, policy);
+    } else {
+        return elementwise(A, A, nullptr, [alpha](T a, T) { return alpha * a; }, policy);
+    }
+}
+
+// Function to sum each row (result is rows x 1)
+template <typename T>
+Matrix<T> rowSums(Matrix<T>& A) {
+    Matrix<T> result(A.numRows(), 1, BufferInit::Uninitialized, A.bufferPolicy()); // Every row stores its sum
+    size_t cols = A.numCols();
+    forEachRowSlab(A.numRows(), [&](size_t startRow, size_t endRow) {
+        for (size_t r = startRow; r < endRow; ++r) {
+            const T* a = A.rowData(r);
+            T total = T(0);
+            size_t j = 0;
+            if constexpr (SimdLanes<T>::available) {
+                using L = SimdLanes<T>;
+                auto sum0 = L::zero(); // Two accumulators hide the add latency
+                auto sum1 = L::zero();
+                for (; j + 16 <= cols; j += 16) {
+                    sum0 = L::add(sum0, L::load(a + j));
+                    sum1 = L::add(sum1, L::load(a + j + 8));
+                }
+                for (; j + 8 <= cols; j += 8) {
+                    sum0 = L::add(sum0, L::load(a + j));
+                }
+                total = L::sum(L::add(sum0, sum1));
+            }
+            for (; j < cols; ++j) {
+                total += a[j];
+            }
+            result.rowData(r)[0] = total;
+        }
+    }, 16);
+    return result;
+}
+
+// Function to sum each column (result is 1 x cols)
+//  Each thread accumulates its slab into a private row, which are then added together.
+template <typename T>
+Matrix<T> colSums(Matrix<T>& A) {
+    Matrix<T> result(1, A.numCols(), BufferInit::Zero, A.bufferPolicy()); // Partial rows are added in
+    size_t cols = A.numCols();
+    std::mutex mergeMutex;
+    forEachRowSlab(A.numRows(), [&](size_t startRow, size_t endRow) {
+        std::vector<T> partial(cols, T(0));
+        for (size_t r = startRow; r < endRow; ++r) {
+            const T* a = A.rowData(r);
+            size_t j = 0;
+            if constexpr (SimdLanes<T>::available) {
+                using L = SimdLanes<T>;
+                for (; j + 8 <= cols; j += 8) {
+                    L::store(partial.data() + j, L::add(L::load(partial.data() + j), L::load(a + j)));
+                }
+            }
+            for (; j < cols; ++j) {
+                partial[j] += a[j];
+            }
+        }
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        T* out = result.rowData(0);
+        for (size_t j = 0; j < cols; ++j) {
+            out[j] += partial[j];
+        }
+    }, 16);
+    return result;
+}
+
+// Function to compute the Frobenius norm sqrt(sum a_ij^2) (accumulated in double)
+template <typename T>
+double frobeniusNorm(Matrix<T>& A) {
+    unsigned long long count = 1ull * A.numRows() * A.numCols();
+    double total = 0;
+    std::mutex mergeMutex;
+    forEachRowSlab(A.numRows(), [&](size_t startRow, size_t endRow) {
+        const T* a = A.rowData(startRow);
+        unsigned long long end = 1ull * (endRow - startRow) * A.numCols();
+        unsigned long long i = 0;
+        double sum = 0;
+        if constexpr (SimdLanes<T>::available) {
+            using L = SimdLanes<T>;
+            __m256d sum0 = _mm256_setzero_pd();
+            __m256d sum1 = _mm256_setzero_pd();
+            for (; i + 8 <= end; i += 8) {
+                auto v = L::load(a + i);
+                __m256d lo = L::lowToDouble(v);
+                __m256d hi = L::highToDouble(v);
+                sum0 = _mm256_fmadd_pd(lo, lo, sum0);
+                sum1 = _mm256_fmadd_pd(hi, hi, sum1);
+            }
+            sum = sumDoubles(_mm256_add_pd(sum0, sum1));
+        }
+        for (; i < end; ++i) {
+            sum += static_cast<double>(a[i]) * static_cast<double>(a[i]);
+        }
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        total += sum;
+    }, 16);
+    return count ? std::sqrt(total) : 0.0;
+}
+
+// Function to compute the max norm max |a_ij|
+template <typename T>
+double maxNorm(Matrix<T>& A) {
+    double best = 0;
+    std::mutex mergeMutex;
+    forEachRowSlab(A.numRows(), [&](size_t startRow, size_t endRow) {
+        const T* a = A.rowData(startRow);
+        unsigned long long end = 1ull * (endRow - startRow) * A.numCols();
+        unsigned long long i = 0;
+        double local = 0;
+        if constexpr (SimdLanes<T>::available) {
+            using L = SimdLanes<T>;
+            auto m = L::zero();
+            for (; i + 8 <= end; i += 8) {
+                m = L::absMax(m, L::load(a + i));
+            }
+            local = L::maxMagnitude(m);
+        }
+        for (; i < end; ++i) {
+            local = std::max(local, std::abs(static_cast<double>(a[i])));
+        }
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        best = std::max(best, local);
+    }, 16);
+    return best;
+}
+
+// Function to multiply a matrix by a column vector (GEMV: y = A x, x is cols x 1, y is rows x 1)
+//  Each row is one dot product; four independent accumulators keep four FMAs in flight, and
+//  every element of A is read exactly once. MT by row blocks.
+template <typename T>
+Matrix<T> mulMatVec(Matrix<T>& A, Matrix<T>& x) {
+    if (A.numCols() != x.numRows() || x.numCols() != 1) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T> y(A.numRows(), 1, BufferInit::Uninitialized, A.bufferPolicy()); // Every row stores its dot product
+    size_t cols = A.numCols();
+    const T* v = x.rowData(0); // A cols x 1 matrix is a contiguous vector
+    forEachRowSlab(A.numRows(), [&](size_t startRow, size_t endRow) {
+        for (size_t r = startRow; r < endRow; ++r) {
+            const T* a = A.rowData(r);
+            T total = T(0);
+            size_t j = 0;
+            if constexpr (SimdLanes<T>::available) {
+                using L = SimdLanes<T>;
+                auto sum0 = L::zero();
+                auto sum1 = L::zero();
+                auto sum2 = L::zero();
+                auto sum3 = L::zero();
+                for (; j + 32 <= cols; j += 32) {
+                    sum0 = L::mulAdd(L::load(a + j), L::load(v + j), sum0);
+                    sum1 = L::mulAdd(L::load(a + j + 8), L::load(v + j + 8), sum1);
+                    sum2 = L::mulAdd(L::load(a + j + 16), L::load(v + j + 16), sum2);
+                    sum3 = L::mulAdd(L::load(a + j + 24), L::load(v + j + 24), sum3);
+                }
+                for (; j + 8 <= cols; j += 8) {
+                    sum0 = L::mulAdd(L::load(a + j), L::load(v + j), sum0);
+                }
+                total = L::sum(L::add(L::add(sum0, sum1), L::add(sum2, sum3)));
+            }
+            for (; j < cols; ++j) {
+                total += a[j] * v[j];
+            }
+            y.rowData(r)[0] = total;
+        }
+    }, 16);
+    return y;
+}
+
+// Function to multiply a row vector by a matrix (GEVM: y = x A, x is 1 x rows, y is 1 x cols)
+//  A is streamed row by row; four rows are folded into the running y per pass, so y is loaded
+//  and stored once per four rows of A. Each row block accumulates a private y, merged at the end.
+template <typename T>
+Matrix<T> mulVecMat(Matrix<T>& x, Matrix<T>& A) {
+    if (x.numRows() != 1 || x.numCols() != A.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    Matrix<T> y(1, A.numCols(), BufferInit::Zero, A.bufferPolicy()); // Partial rows are added in
+    size_t cols = A.numCols();
+    const T* v = x.rowData(0);
+    std::mutex mergeMutex;
+    forEachRowSlab(A.numRows(), [&](size_t startRow, size_t endRow) {
+        std::vector<T> partial(cols, T(0));
+        T* p = partial.data();
+        size_t r = startRow;
+        for (; r + 4 <= endRow; r += 4) {
+            const T* a0 = A.rowData(r);
+            const T* a1 = A.rowData(r + 1);
+            const T* a2 = A.rowData(r + 2);
+            const T* a3 = A.rowData(r + 3);
+            size_t j = 0;
+            if constexpr (SimdLanes<T>::available) {
+                using L = SimdLanes<T>;
+                auto x0 = L::set1(v[r]);
+                auto x1 = L::set1(v[r + 1]);
+                auto x2 = L::set1(v[r + 2]);
+                auto x3 = L::set1(v[r + 3]);
+                for (; j + 8 <= cols; j += 8) {
+                    auto acc = L::mulAdd(x0, L::load(a0 + j), L::load(p + j));
+                    acc = L::mulAdd(x1, L::load(a1 + j), acc);
+                    acc = L::mulAdd(x2, L::load(a2 + j), acc);
+                    acc = L::mulAdd(x3, L::load(a3 + j), acc);
+                    L::store(p + j, acc);
+                }
+            }
+            for (; j < cols; ++j) {
+                p[j] += v[r] * a0[j] + v[r + 1] * a1[j] + v[r + 2] * a2[j] + v[r + 3] * a3[j];
+            }
+        }
+        for (; r < endRow; ++r) {
+            const T* a = A.rowData(r);
+            for (size_t j = 0; j < cols; ++j) {
+                p[j] += v[r] * a[j];
+            }
+        }
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        T* out = y.rowData(0);
+        for (size_t j = 0; j < cols; ++j) {
+            out[j] += p[j];
+        }
+    }, 16);
+    return y;
+}
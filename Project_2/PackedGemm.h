@@ -0,0 +1,272 @@
+//
+// file: PackedGemm.h
+// desc: ACS Project 2 Packed Multiplication Header
+// auth: Andrew Prata
+//
+// This header file contains a GEMM that packs its
+// operands before multiplying, in the style of BLIS.
+// B is packed one K panel at a time into 16-column
+// strips by a helper thread, into one of two buffers,
+// so panel k + 1 is being packed while the compute
+// threads consume panel k. Each compute thread packs
+// its own rows of A into 4-row micro panels in a
+// private arena that is reused for every panel.
+// Include it after MatrixOps.h (for SimdLanes).
+//
+
+// Micro-kernel shape and K panel depth
+constexpr size_t packedMR = 4;   // Rows of C per micro-kernel call
+constexpr size_t packedNR = 16;  // Columns of C per micro-kernel call (two AVX registers of 4-byte T)
+constexpr size_t packedKC = 256; // Depth of one K panel
+
+// Per-phase timing for one mulMatPacked call (thread phases are summed over compute threads)
+struct PackedGemmStats {
+    size_t computeThreads = 0;
+    size_t panels = 0;
+    bool overlapped = false;             // Whether B packing ran behind the compute
+    double totalSeconds = 0;
+    double packBSeconds = 0;             // Helper thread packing B panels
+    double packASeconds = 0;             // Compute threads packing their A micro panels
+    double computeSeconds = 0;           // Compute threads in the micro-kernel
+    double waitSeconds = 0;              // Compute threads blocked at the panel barrier
+    unsigned long long arenaBytes = 0;   // Per-thread A arenas plus both B buffers
+};
+
+// Micro-kernel: C[rows x cols] += Ap (MR x kc, k-major) x Bp (kc x NR, k-major)
+//  The MR x NR accumulator tile is small enough for the compiler to keep in registers.
+template <typename T>
+void packedMicroKernel(const T* a, const T* b, size_t kc, T* c, size_t ldc, size_t rows, size_t cols) {
+    if constexpr (SimdLanes<T>::available && packedNR == 16) {
+        // Eight named accumulators (4 rows x 2 registers), so they stay in registers
+        using L = SimdLanes<T>;
+        auto c00 = L::zero(), c01 = L::zero(), c10 = L::zero(), c11 = L::zero();
+        auto c20 = L::zero(), c21 = L::zero(), c30 = L::zero(), c31 = L::zero();
+        for (size_t k = 0; k < kc; ++k) {
+            auto b0 = L::load(b + k * packedNR);
+            auto b1 = L::load(b + k * packedNR + 8);
+            const T* ak = a + k * packedMR;
+            auto a0 = L::set1(ak[0]);
+            c00 = L::mulAdd(a0, b0, c00);
+            c01 = L::mulAdd(a0, b1, c01);
+            auto a1 = L::set1(ak[1]);
+            c10 = L::mulAdd(a1, b0, c10);
+            c11 = L::mulAdd(a1, b1, c11);
+            auto a2 = L::set1(ak[2]);
+            c20 = L::mulAdd(a2, b0, c20);
+            c21 = L::mulAdd(a2, b1, c21);
+            auto a3 = L::set1(ak[3]);
+            c30 = L::mulAdd(a3, b0, c30);
+            c31 = L::mulAdd(a3, b1, c31);
+        }
+        alignas(32) T acc[packedMR][packedNR];
+        L::store(acc[0], c00);
+        L::store(acc[0] + 8, c01);
+        L::store(acc[1], c10);
+        L::store(acc[1] + 8, c11);
+        L::store(acc[2], c20);
+        L::store(acc[2] + 8, c21);
+        L::store(acc[3], c30);
+        L::store(acc[3] + 8, c31);
+        for (size_t r = 0; r < rows; ++r) {
+            T* cr = c + 1ull * r * ldc;
+            for (size_t j = 0; j < cols; ++j) {
+                cr[j] += acc[r][j];
+            }
+        }
+        return;
+    }
+    T acc[packedMR][packedNR] = {};
+    for (size_t k = 0; k < kc; ++k) {
+        const T* bk = b + k * packedNR;
+        for (size_t r = 0; r < packedMR; ++r) {
+            T ar = a[k * packedMR + r];
+            for (size_t j = 0; j < packedNR; ++j) {
+                acc[r][j] += ar * bk[j];
+            }
+        }
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        T* cr = c + 1ull * r * ldc;
+        for (size_t j = 0; j < cols; ++j) {
+            cr[j] += acc[r][j];
+        }
+    }
+}
+
+// Helper to pack B[k0:k0+kc, :] into NR-column strips (zero padded on the right)
+template <typename T>
+void packPanelB(Matrix<T>& B, size_t k0, size_t kc, T* out) {
+    size_t n = B.numCols();
+    for (size_t s = 0; s * packedNR < n; ++s) {
+        size_t col0 = s * packedNR;
+        size_t width = std::min(packedNR, n - col0);
+        T* strip = out + 1ull * s * kc * packedNR;
+        for (size_t k = 0; k < kc; ++k) {
+            const T* src = B.rowData(k0 + k) + col0;
+            T* dst = strip + k * packedNR;
+            for (size_t j = 0; j < width; ++j) {
+                dst[j] = src[j];
+            }
+            for (size_t j = width; j < packedNR; ++j) {
+                dst[j] = T(0);
+            }
+        }
+    }
+}
+
+// Helper to pack A[row0:row1, k0:k0+kc] into MR-row micro panels (zero padded at the bottom)
+template <typename T>
+void packPanelA(Matrix<T>& A, size_t row0, size_t row1, size_t k0, size_t kc, T* out) {
+    for (size_t m = 0; row0 + m * packedMR < row1; ++m) {
+        T* panel = out + 1ull * m * kc * packedMR;
+        for (size_t r = 0; r < packedMR; ++r) {
+            size_t row = row0 + m * packedMR + r;
+            if (row < row1) {
+                const T* src = A.rowData(row) + k0;
+                for (size_t k = 0; k < kc; ++k) {
+                    panel[k * packedMR + r] = src[k];
+                }
+            } else {
+                for (size_t k = 0; k < kc; ++k) {
+                    panel[k * packedMR + r] = T(0);
+                }
+            }
+        }
+    }
+}
+
+// Function to multiply with packed operands and double-buffered B panels
+//  overlap = false packs each B panel while the compute threads wait (the single-buffer
+//  baseline), so the two runs differ only in whether packing is hidden behind compute.
+template <typename T>
+Matrix<T> mulMatPacked(Matrix<T>& A, Matrix<T>& B, PackedGemmStats* statsOut = nullptr, bool overlap = true) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    using clock = std::chrono::high_resolution_clock;
+    auto seconds = [](clock::time_point start) {
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+    auto startTotal = clock::now();
+    size_t m = A.numRows();
+    size_t kTotal = A.numCols();
+    size_t n = B.numCols();
+    Matrix<T> C(m, n, BufferInit::Zero, A.bufferPolicy()); // Accumulated into, one K panel at a time
+    size_t panels = (kTotal + packedKC - 1) / packedKC;
+    size_t strips = (n + packedNR - 1) / packedNR;
+    size_t numThreads = std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                              (m + packedMR - 1) / packedMR));
+
+    PackedGemmStats stats;
+    stats.computeThreads = numThreads;
+    stats.panels = panels;
+    stats.overlapped = overlap;
+    if (panels == 0 || m == 0 || n == 0) {
+        if (statsOut != nullptr) {
+            *statsOut = stats;
+        }
+        return C;
+    }
+
+    // Two B panel buffers, shared by all compute threads
+    const BufferPolicy& policy = A.bufferPolicy();
+    MatrixBuffer<T> packedB[2] = {MatrixBuffer<T>(strips * packedKC * packedNR, BufferInit::Uninitialized, policy),
+                                  MatrixBuffer<T>(overlap ? strips * packedKC * packedNR : 0, BufferInit::Uninitialized, policy)};
+    std::vector<double> packA(numThreads, 0);
+    std::vector<double> compute(numThreads, 0);
+    std::vector<double> wait(numThreads, 0);
+    std::vector<unsigned long long> arenaBytes(numThreads, 0);
+    std::barrier sync(static_cast<std::ptrdiff_t>(numThreads + 1)); // Compute threads + packer
+    auto panelDepth = [&](size_t p) {
+        return std::min(packedKC, kTotal - p * packedKC);
+    };
+
+    // Helper thread: keeps the next B panel packed ahead of the compute threads
+    auto packer = [&] {
+        auto pack = [&](size_t p, T* out) {
+            auto start = clock::now();
+            packPanelB(B, p * packedKC, panelDepth(p), out);
+            stats.packBSeconds += seconds(start);
+        };
+        if (overlap) {
+            pack(0, packedB[0].data());
+            sync.arrive_and_wait();
+            for (size_t p = 0; p < panels; ++p) {
+                if (p + 1 < panels) {
+                    pack(p + 1, packedB[(p + 1) % 2].data()); // Runs while panel p is consumed
+                }
+                sync.arrive_and_wait();
+            }
+        } else {
+            for (size_t p = 0; p < panels; ++p) {
+                pack(p, packedB[0].data()); // Compute threads are parked at the barrier meanwhile
+                sync.arrive_and_wait();
+                sync.arrive_and_wait();
+            }
+        }
+    };
+
+    // Compute thread: owns rows [row0, row1) of C and a private arena for its A micro panels
+    auto worker = [&](size_t id) {
+        size_t row0 = (id * m) / numThreads;
+        size_t row1 = ((id + 1) * m) / numThreads;
+        size_t microPanels = (row1 - row0 + packedMR - 1) / packedMR;
+        MatrixBuffer<T> arena(microPanels * packedMR * packedKC, BufferInit::Uninitialized, policy); // Reused for every panel
+        arenaBytes[id] = 1ull * arena.size() * sizeof(T);
+        auto barrier = [&] {
+            auto start = clock::now();
+            sync.arrive_and_wait();
+            wait[id] += seconds(start);
+        };
+        barrier(); // Wait for panel 0 to be packed
+        for (size_t p = 0; p < panels; ++p) {
+            size_t kc = panelDepth(p);
+            const T* b = packedB[overlap ? p % 2 : 0].data();
+
+            auto startPack = clock::now();
+            packPanelA(A, row0, row1, p * packedKC, kc, arena.data());
+            packA[id] += seconds(startPack);
+
+            auto startCompute = clock::now();
+            for (size_t mp = 0; mp < microPanels; ++mp) {
+                size_t row = row0 + mp * packedMR;
+                size_t rows = std::min(packedMR, row1 - row);
+                const T* a = arena.data() + 1ull * mp * packedMR * kc;
+                for (size_t s = 0; s < strips; ++s) {
+                    size_t col = s * packedNR;
+                    packedMicroKernel(a, b + 1ull * s * kc * packedNR, kc,
+                                      C.rowData(row) + col, n, rows, std::min(packedNR, n - col));
+                }
+            }
+            compute[id] += seconds(startCompute);
+
+            barrier(); // Panel p consumed (and, when overlapped, panel p + 1 packed)
+            if (!overlap && p + 1 < panels) {
+                barrier(); // Wait for the packer to refill the single buffer
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t id = 0; id < numThreads; ++id) {
+        threads.emplace_back(worker, id);
+    }
+    packer();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    stats.totalSeconds = seconds(startTotal);
+    for (size_t id = 0; id < numThreads; ++id) {
+        stats.packASeconds += packA[id];
+        stats.computeSeconds += compute[id];
+        stats.waitSeconds += wait[id];
+        stats.arenaBytes += arenaBytes[id];
+    }
+    stats.arenaBytes += 1ull * (packedB[0].size() + packedB[1].size()) * sizeof(T);
+    if (statsOut != nullptr) {
+        *statsOut = stats;
+    }
+    return C;
+}
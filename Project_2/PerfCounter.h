@@ -0,0 +1,123 @@
+//
+// file: PerfCounter.h
+// desc: ACS Project 2 Hardware Counter Header
+// auth: Andrew Prata
+//
+// This header file contains a small wrapper around
+// Linux perf_event_open, used to count hardware events
+// (dTLB misses, LLC misses, page faults) around a
+// single kernel call. On other platforms, or when the
+// kernel refuses access, counters report unavailable.
+//
+
+#pragma once
+
+#include <cstdint>  // std::uint64_t
+#include <cstring>  // std::memset
+#ifdef __linux__
+#include <linux/perf_event.h> // perf_event_attr
+#include <sys/ioctl.h>        // ioctl
+#include <sys/syscall.h>      // SYS_perf_event_open
+#include <unistd.h>           // syscall/read/close
+#endif
+
+// Events we know how to count
+enum class PerfEvent { DTLBLoadMisses, LLCLoadMisses, LLCLoads, PageFaults, Cycles };
+
+inline const char* perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::DTLBLoadMisses: return "dTLB load misses";
+        case PerfEvent::LLCLoadMisses:  return "LLC load misses";
+        case PerfEvent::LLCLoads:       return "LLC loads";
+        case PerfEvent::PageFaults:     return "page faults";
+        case PerfEvent::Cycles:         return "cycles";
+    }
+    return "unknown";
+}
+
+// One hardware/software counter for the calling thread and every thread it spawns afterwards
+class PerfCounter {
+private:
+    int fd = -1;
+
+public:
+    explicit PerfCounter(PerfEvent event) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.inherit = 1;        // Kernels spawn std::threads after start(), count those too
+        attr.exclude_kernel = 1; // Works with perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        switch (event) {
+            case PerfEvent::DTLBLoadMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case PerfEvent::LLCLoadMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case PerfEvent::LLCLoads:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16);
+                break;
+            case PerfEvent::PageFaults:
+                attr.type = PERF_TYPE_SOFTWARE;
+                attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+                break;
+            case PerfEvent::Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+        }
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    // Whether the OS granted access to this counter
+    bool available() const {
+        return fd >= 0;
+    }
+
+    // Zero and begin counting
+    void start() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stop counting and return the count (-1 if unavailable)
+    long long stop() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t value = 0;
+            if (read(fd, &value, sizeof(value)) == sizeof(value)) {
+                return static_cast<long long>(value);
+            }
+        }
+#endif
+        return -1;
+    }
+};
@@ -0,0 +1,369 @@
+//
+// file: ProcessGemm.h
+// desc: ACS Project 2 Multi-Process Multiplication Header
+// auth: Andrew Prata
+//
+// This header file contains a GEMM that runs on worker
+// processes instead of threads. A, B and C are placed
+// in one POSIX shared memory segment, forked workers
+// map it, and the parent hands out C tiles one at a
+// time over a UNIX domain socket per worker. Workers
+// share nothing but that segment, so this is the
+// baseline for scaling past one address space.
+// A thread version over the same tile kernel is
+// included for comparison. Include it after Matrix.h.
+//
+
+#pragma once
+
+// Matrix.h redefines size_t; system headers must see the real one
+#pragma push_macro("size_t")
+#undef size_t
+#include <algorithm>    // std::min/std::max/std::copy
+#include <atomic>       // Segment counter, tile counter
+#include <cerrno>       // errno/EINTR
+#include <chrono>       // Stage timings
+#include <stdexcept>    // std::runtime_error/std::invalid_argument
+#include <string>       // Segment name
+#include <thread>       // mulMatTileThreads
+#include <vector>
+#include <fcntl.h>      // O_CREAT/O_EXCL/O_RDWR
+#include <poll.h>       // poll
+#include <sys/mman.h>   // shm_open/mmap/munmap/shm_unlink
+#include <sys/socket.h> // socketpair/send/recv
+#include <sys/wait.h>   // waitpid
+#include <unistd.h>     // fork/ftruncate/getpid/close/_exit
+#pragma pop_macro("size_t")
+
+// One C tile handed to a worker (rows == 0 tells the worker to exit)
+struct TileAssignment {
+    unsigned int row0;
+    unsigned int col0;
+    unsigned int rows;
+    unsigned int cols;
+};
+
+// Timing for one multi-process (or multi-thread) multiplication
+struct ProcessGemmStats {
+    size_t workers = 0;       // Processes (or threads) used
+    size_t tiles = 0;         // C tiles handed out
+    double setupSeconds = 0;  // Segment creation, copying A and B in, forking
+    double computeSeconds = 0; // First tile sent -> last tile done
+    double copyOutSeconds = 0; // Copying C out of the segment
+};
+
+// Helper to number segments, so concurrent calls in one process get distinct names
+inline unsigned long long nextSharedSegmentId() {
+    static std::atomic<unsigned long long> counter{0};
+    return counter++;
+}
+
+// Shared memory segment holding A (m x k), B (k x n) and C (m x n), each 64-byte aligned
+template <typename T>
+class SharedGemmSegment {
+private:
+    std::string name;
+    int fd = -1;
+    void* base = MAP_FAILED;
+    unsigned long long bytes = 0;
+    unsigned long long offsetB = 0;
+    unsigned long long offsetC = 0;
+
+    static unsigned long long alignUp(unsigned long long value) {
+        return (value + 63) & ~63ull;
+    }
+
+public:
+    SharedGemmSegment(size_t m, size_t k, size_t n)
+        : name("/matTest_gemm_" + std::to_string(getpid()) + "_" + std::to_string(nextSharedSegmentId())) {
+        offsetB = alignUp(1ull * m * k * sizeof(T));
+        offsetC = offsetB + alignUp(1ull * k * n * sizeof(T));
+        bytes = offsetC + alignUp(1ull * m * n * sizeof(T));
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("shm_open failed for " + name);
+        }
+        // A fresh segment reads as zeros, so C needs no initialization
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("ftruncate failed for " + name);
+        }
+        base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("mmap failed for " + name);
+        }
+    }
+
+    ~SharedGemmSegment() {
+        if (base != MAP_FAILED) {
+            munmap(base, bytes);
+        }
+        if (fd >= 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+        }
+    }
+
+    SharedGemmSegment(const SharedGemmSegment&) = delete;
+    SharedGemmSegment& operator=(const SharedGemmSegment&) = delete;
+
+    // Segment name (a separately launched worker could shm_open and map it)
+    const std::string& segmentName() const {
+        return name;
+    }
+
+    T* a() {
+        return static_cast<T*>(base);
+    }
+
+    T* b() {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offsetB);
+    }
+
+    T* c() {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offsetC);
+    }
+};
+
+// Function to compute one C tile from raw row-major operands: C[tile] = A[rows, :] x B[:, cols]
+template <typename T>
+void mulTileRaw(const T* A, const T* B, T* C, size_t k, size_t n, TileAssignment tile) {
+    // Locals, not tile fields: an int C could alias unsigned fields and block vectorization
+    const size_t rowEnd = tile.row0 + tile.rows;
+    const size_t col0 = tile.col0;
+    const size_t cols = tile.cols;
+    for (size_t i = tile.row0; i < rowEnd; ++i) {
+        const T* a = A + 1ull * i * k;
+        T* c = C + 1ull * i * n + col0;
+        for (size_t kk = 0; kk < k; ++kk) {
+            T aik = a[kk];
+            const T* b = B + 1ull * kk * n + col0;
+            for (size_t j = 0; j < cols; ++j) {
+                c[j] += aik * b[j];
+            }
+        }
+    }
+}
+
+// Helper to move exactly `length` bytes over a socket (false if the peer is gone)
+inline bool sendAll(int socket, const void* buffer, unsigned long long length) {
+    const char* p = static_cast<const char*>(buffer);
+    while (length > 0) {
+        ssize_t sent = send(socket, p, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        p += sent;
+        length -= static_cast<unsigned long long>(sent);
+    }
+    return true;
+}
+
+inline bool receiveAll(int socket, void* buffer, unsigned long long length) {
+    char* p = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t received = recv(socket, p, length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        p += received;
+        length -= static_cast<unsigned long long>(received);
+    }
+    return true;
+}
+
+// Worker process body: compute tiles until told to stop, acknowledging each one
+template <typename T>
+[[noreturn]] void gemmWorkerProcess(int socket, const T* A, const T* B, T* C, size_t k, size_t n) {
+    TileAssignment tile;
+    while (receiveAll(socket, &tile, sizeof(tile)) && tile.rows != 0) {
+        mulTileRaw(A, B, C, k, n, tile);
+        char done = 1;
+        if (!sendAll(socket, &done, 1)) {
+            break;
+        }
+    }
+    close(socket);
+    _exit(0); // Skip the parent's atexit handlers and static destructors
+}
+
+// Helper to list the C tiles in row-major order
+inline std::vector<TileAssignment> gemmTiles(size_t m, size_t n, size_t tile) {
+    std::vector<TileAssignment> tiles;
+    for (size_t row = 0; row < m; row += tile) {
+        for (size_t col = 0; col < n; col += tile) {
+            tiles.push_back({row, col, std::min(tile, m - row), std::min(tile, n - col)});
+        }
+    }
+    return tiles;
+}
+
+// Function to compute C = A x B on forked worker processes sharing one memory segment
+//  Tiles are assigned dynamically: each worker gets a new tile as soon as it acknowledges
+//  the previous one, so faster workers take more tiles.
+template <typename T>
+ProcessGemmStats mulMatProcesses(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C, size_t numProcesses, size_t tile = 128) {
+    if (A.numCols() != B.numRows() || A.numRows() != C.numRows() || B.numCols() != C.numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    using clock = std::chrono::high_resolution_clock;
+    size_t m = A.numRows();
+    size_t k = A.numCols();
+    size_t n = B.numCols();
+    ProcessGemmStats stats;
+    if (m == 0 || n == 0) {
+        return stats; // C is empty: no tiles, no workers, no segment
+    }
+    std::vector<TileAssignment> tiles = gemmTiles(m, n, tile);
+    numProcesses = std::max(1u, std::min(numProcesses, static_cast<size_t>(tiles.size())));
+    stats.workers = numProcesses;
+    stats.tiles = tiles.size();
+
+    auto startSetup = clock::now();
+    SharedGemmSegment<T> segment(m, k, n);
+    std::copy(A.storage(), A.storage() + 1ull * m * k, segment.a());
+    std::copy(B.storage(), B.storage() + 1ull * k * n, segment.b());
+
+    // One socket pair per worker; the parent keeps end [0], the child end [1]
+    std::vector<int> sockets;
+    std::vector<pid_t> children;
+    // Tell every worker to exit, then reap them (false if any worker died on its own)
+    auto stopWorkers = [&] {
+        TileAssignment stop{0, 0, 0, 0};
+        for (int socket : sockets) {
+            sendAll(socket, &stop, sizeof(stop));
+            close(socket);
+        }
+        bool clean = true;
+        for (pid_t pid : children) {
+            int status = 0;
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                clean = false;
+            }
+        }
+        return clean;
+    };
+    for (size_t w = 0; w < numProcesses; ++w) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+            stopWorkers();
+            throw std::runtime_error("socketpair failed");
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(pair[0]);
+            close(pair[1]);
+            stopWorkers();
+            throw std::runtime_error("fork failed");
+        }
+        if (pid == 0) {
+            for (int other : sockets) {
+                close(other); // Siblings' control sockets belong to the parent only
+            }
+            close(pair[0]);
+            gemmWorkerProcess(pair[1], segment.a(), segment.b(), segment.c(), k, n);
+        }
+        close(pair[1]);
+        sockets.push_back(pair[0]);
+        children.push_back(pid);
+    }
+    auto startCompute = clock::now();
+    stats.setupSeconds = std::chrono::duration<double>(startCompute - startSetup).count();
+
+    // Prime every worker with one tile, then hand out the rest as acknowledgements come back
+    size_t nextTile = 0;
+    size_t busy = 0;
+    bool workerLost = false;
+    for (int socket : sockets) {
+        if (sendAll(socket, &tiles[nextTile], sizeof(TileAssignment))) {
+            ++nextTile;
+            ++busy;
+        } else {
+            workerLost = true;
+        }
+    }
+    std::vector<pollfd> polls;
+    for (int socket : sockets) {
+        polls.push_back({socket, POLLIN, 0});
+    }
+    while (busy > 0 && !workerLost) {
+        if (poll(polls.data(), polls.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            workerLost = true;
+            break;
+        }
+        for (pollfd& p : polls) {
+            if (!(p.revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            char done = 0;
+            if (!receiveAll(p.fd, &done, 1)) {
+                workerLost = true;
+                break;
+            }
+            --busy;
+            if (nextTile < tiles.size()) {
+                if (!sendAll(p.fd, &tiles[nextTile], sizeof(TileAssignment))) {
+                    workerLost = true;
+                    break;
+                }
+                ++nextTile;
+                ++busy;
+            }
+        }
+    }
+    auto stopCompute = clock::now();
+    stats.computeSeconds = std::chrono::duration<double>(stopCompute - startCompute).count();
+
+    if (!stopWorkers() || workerLost) {
+        throw std::runtime_error("Worker process exited unexpectedly");
+    }
+
+    std::copy(segment.c(), segment.c() + 1ull * m * n, C.storage());
+    stats.copyOutSeconds = std::chrono::duration<double>(clock::now() - stopCompute).count();
+    return stats;
+}
+
+// Function to compute C += A x B on threads pulling the same tiles (C zero for a plain product)
+//  This is the shared-address-space baseline for mulMatProcesses.
+template <typename T>
+ProcessGemmStats mulMatTileThreads(Matrix<T>& A, Matrix<T>& B, Matrix<T>& C, size_t numThreads, size_t tile = 128) {
+    if (A.numCols() != B.numRows() || A.numRows() != C.numRows() || B.numCols() != C.numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    std::vector<TileAssignment> tiles = gemmTiles(A.numRows(), B.numCols(), tile);
+    numThreads = std::max(1u, std::min(numThreads, static_cast<size_t>(tiles.size())));
+    ProcessGemmStats stats;
+    stats.workers = numThreads;
+    stats.tiles = tiles.size();
+    std::atomic<size_t> nextTile{0};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t threadID = 0; threadID < numThreads; ++threadID) {
+        threads.emplace_back([&] {
+            for (size_t t = nextTile++; t < tiles.size(); t = nextTile++) {
+                mulTileRaw<T>(A.storage(), B.storage(), C.storage(), A.numCols(), B.numCols(), tiles[t]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stats.computeSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return stats;
+}
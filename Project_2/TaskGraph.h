@@ -0,0 +1,319 @@
+//
+// file: TaskGraph.h
+// desc: ACS Project 2 Coroutine Task Graph Header
+// auth: Andrew Prata
+//
+// This header file contains a small C++20 coroutine
+// scheduler and a tiled GEMM built on it. Every output
+// tile is a coroutine whose K-panel updates wait on the
+// exact input tiles they read, so a multiply can start
+// consuming an upstream result before all of it exists.
+// Include it after Matrix.h.
+//
+
+class TileScheduler;
+
+// Coroutine type for one unit of work in the graph (fire-and-forget, owned by the scheduler)
+struct TileTask {
+    struct promise_type {
+        TileScheduler* scheduler = nullptr;
+        std::exception_ptr error;
+
+        TileTask get_return_object() {
+            return TileTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; } // Started by TileScheduler::spawn
+        auto final_suspend() noexcept;
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Thread pool that resumes ready coroutines in FIFO order
+class TileScheduler {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::coroutine_handle<>> ready;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::condition_variable idleCondition;
+    size_t outstanding = 0; // Spawned tasks that have not reached final_suspend
+    bool stopping = false;
+    std::exception_ptr firstError;
+
+    void workerLoop() {
+        while (true) {
+            std::coroutine_handle<> next;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueCondition.wait(lock, [this] { return stopping || !ready.empty(); });
+                if (ready.empty()) {
+                    return; // Stopping and drained
+                }
+                next = ready.front();
+                ready.pop_front();
+            }
+            next.resume();
+        }
+    }
+
+public:
+    // Constructor (numThreads = 0 uses every hardware thread)
+    explicit TileScheduler(size_t numThreads = 0) {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < numThreads; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~TileScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueCondition.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Queue a suspended coroutine to be resumed on a worker
+    void schedule(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            ready.push_back(handle);
+        }
+        queueCondition.notify_one();
+    }
+
+    // Hand a new task to the scheduler and start it
+    void spawn(TileTask task) {
+        task.handle.promise().scheduler = this;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            ++outstanding;
+        }
+        schedule(task.handle);
+    }
+
+    // Called from final_suspend of each task (error is set if the task threw)
+    void taskFinished(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (error && !firstError) {
+            firstError = error;
+        }
+        if (--outstanding == 0) {
+            idleCondition.notify_all();
+        }
+    }
+
+    // Block until every spawned task has finished (rethrows the first task exception)
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        idleCondition.wait(lock, [this] { return outstanding == 0; });
+        if (firstError) {
+            std::exception_ptr error = firstError;
+            firstError = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+inline auto TileTask::promise_type::final_suspend() noexcept {
+    // Report completion, then let the frame destroy itself
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+            TileScheduler* scheduler = h.promise().scheduler;
+            std::exception_ptr error = h.promise().error;
+            h.destroy();
+            scheduler->taskFinished(error);
+            return true;
+        }
+        void await_resume() noexcept {}
+    };
+    return FinalAwaiter{};
+}
+
+inline void TileTask::promise_type::unhandled_exception() {
+    error = std::current_exception(); // Handed to the scheduler at final_suspend
+}
+
+// One-shot event: coroutines that co_await it are rescheduled once it is set
+class TileEvent {
+private:
+    TileScheduler& scheduler;
+    std::mutex eventMutex;
+    bool isSet = false;
+    std::vector<std::coroutine_handle<>> waiters;
+
+public:
+    explicit TileEvent(TileScheduler& scheduler) : scheduler(scheduler) {}
+
+    void set() {
+        std::vector<std::coroutine_handle<>> toResume;
+        {
+            std::lock_guard<std::mutex> lock(eventMutex);
+            isSet = true;
+            toResume.swap(waiters);
+        }
+        for (auto handle : toResume) {
+            scheduler.schedule(handle);
+        }
+    }
+
+    auto operator co_await() {
+        struct Awaiter {
+            TileEvent& event;
+            bool await_ready() {
+                std::lock_guard<std::mutex> lock(event.eventMutex);
+                return event.isSet;
+            }
+            bool await_suspend(std::coroutine_handle<> h) {
+                std::lock_guard<std::mutex> lock(event.eventMutex);
+                if (event.isSet) {
+                    return false; // Set while we were getting here, keep running
+                }
+                event.waiters.push_back(h);
+                return true;
+            }
+            void await_resume() {}
+        };
+        return Awaiter{*this};
+    }
+};
+
+// Row-major matrix cut into square tiles, with a completion event per tile
+template <typename T>
+class TiledMatrix {
+private:
+    Matrix<T>& matrix;
+    size_t tile;
+    size_t tileRows;
+    size_t tileCols;
+    std::vector<std::unique_ptr<TileEvent>> events;
+
+public:
+    // ready = true for inputs that already hold their final values
+    TiledMatrix(Matrix<T>& matrix, size_t tile, TileScheduler& scheduler, bool ready)
+        : matrix(matrix), tile(tile),
+          tileRows((matrix.numRows() + tile - 1) / tile), tileCols((matrix.numCols() + tile - 1) / tile) {
+        for (size_t i = 0; i < tileRows * tileCols; ++i) {
+            events.push_back(std::make_unique<TileEvent>(scheduler));
+            if (ready) {
+                events.back()->set();
+            }
+        }
+    }
+
+    Matrix<T>& data() {
+        return matrix;
+    }
+
+    size_t tileSize() const {
+        return tile;
+    }
+
+    size_t numTileRows() const {
+        return tileRows;
+    }
+
+    size_t numTileCols() const {
+        return tileCols;
+    }
+
+    // Event for tile (ti, tj); co_await it to wait until the tile is final
+    TileEvent& tileReady(size_t ti, size_t tj) {
+        return *events[ti * tileCols + tj];
+    }
+};
+
+// Function to accumulate one K panel into one C tile: C[ti,tj] += A[ti,tk] x B[tk,tj]
+template <typename T>
+void mulAddTile(TiledMatrix<T>& A, TiledMatrix<T>& B, TiledMatrix<T>& C, size_t ti, size_t tj, size_t tk) {
+    size_t t = C.tileSize();
+    size_t rowEnd = std::min((ti + 1) * t, C.data().numRows());
+    size_t colStart = tj * t;
+    size_t colEnd = std::min((tj + 1) * t, C.data().numCols());
+    size_t kStart = tk * t;
+    size_t kEnd = std::min((tk + 1) * t, A.data().numCols());
+    for (size_t i = ti * t; i < rowEnd; ++i) {
+        T* a = A.data().rowData(i);
+        T* c = C.data().rowData(i);
+        for (size_t k = kStart; k < kEnd; ++k) {
+            T aik = a[k];
+            T* b = B.data().rowData(k);
+            for (size_t j = colStart; j < colEnd; ++j) {
+                c[j] += aik * b[j];
+            }
+        }
+    }
+}
+
+// Coroutine for one output tile: one K-panel update per step, each waiting on its two input tiles
+template <typename T>
+TileTask tileProductTask(TiledMatrix<T>& A, TiledMatrix<T>& B, TiledMatrix<T>& C, size_t ti, size_t tj) {
+    for (size_t tk = 0; tk < A.numTileCols(); ++tk) {
+        co_await A.tileReady(ti, tk);
+        co_await B.tileReady(tk, tj);
+        mulAddTile(A, B, C, ti, tj, tk);
+    }
+    C.tileReady(ti, tj).set(); // Downstream panels that read this tile may now run
+}
+
+// Function to add C = A x B to the task graph (C must be zero and is marked ready tile by tile)
+template <typename T>
+void submitTiledMultiply(TileScheduler& scheduler, TiledMatrix<T>& A, TiledMatrix<T>& B, TiledMatrix<T>& C) {
+    if (A.data().numCols() != B.data().numRows() || A.data().numRows() != C.data().numRows() ||
+        B.data().numCols() != C.data().numCols()) {
+        throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+    }
+    if (A.tileSize() != B.tileSize() || A.tileSize() != C.tileSize()) {
+        throw std::invalid_argument("Task graph operands must use the same tile size");
+    }
+    // Row-major submission order, so upstream rows of tiles finish (and unblock) first
+    for (size_t ti = 0; ti < C.numTileRows(); ++ti) {
+        for (size_t tj = 0; tj < C.numTileCols(); ++tj) {
+            scheduler.spawn(tileProductTask(A, B, C, ti, tj));
+        }
+    }
+}
+
+// Function to multiply a chain M0 x M1 x ... left to right as one pipelined task graph
+//  Every product in the chain is submitted up front; a downstream tile starts its first
+//  K panel as soon as the matching upstream tiles are done, with no barrier in between.
+template <typename T>
+Matrix<T> mulChainTaskGraph(std::vector<Matrix<T>>& chain, size_t tile = 128) {
+    if (chain.empty()) {
+        throw std::invalid_argument("Cannot multiply an empty chain");
+    }
+    // Check every link before spawning anything: a throw after the first spawn would unwind the
+    //  tiles and partials while worker threads still run tasks that point into them
+    for (size_t m = 1; m < chain.size(); ++m) {
+        if (chain[m - 1].numCols() != chain[m].numRows()) {
+            throw std::invalid_argument("Matrix dimensions are not compatible for multiplication");
+        }
+    }
+    TileScheduler scheduler;
+    std::vector<Matrix<T>> partials;   // Intermediate and final products
+    partials.reserve(chain.size() - 1); // No reallocation: TiledMatrix keeps references
+    std::vector<std::unique_ptr<TiledMatrix<T>>> tiled;
+    tiled.push_back(std::make_unique<TiledMatrix<T>>(chain[0], tile, scheduler, true));
+    for (size_t m = 1; m < chain.size(); ++m) {
+        TiledMatrix<T>& left = *tiled.back();
+        tiled.push_back(std::make_unique<TiledMatrix<T>>(chain[m], tile, scheduler, true));
+        TiledMatrix<T>& right = *tiled.back();
+        partials.emplace_back(left.data().numRows(), chain[m].numCols());
+        tiled.push_back(std::make_unique<TiledMatrix<T>>(partials.back(), tile, scheduler, false));
+        submitTiledMultiply(scheduler, left, right, *tiled.back());
+    }
+    scheduler.waitIdle();
+    if (partials.empty()) {
+        return chain[0];
+    }
+    return partials.back();
+}
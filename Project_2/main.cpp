@@ -18,7 +18,35 @@
 #include <thread>
 #include <chrono>
 #include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <filesystem>
+#include <future>
+#include <coroutine>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <exception>
+#include <functional>
+#include <barrier>
+#include <atomic>
+#include <limits>
+#ifdef MATTEST_PARALLEL_STL
+#include <execution>    // std::execution::par_unseq (link with -ltbb)
+#endif
+#include "PerfCounter.h"
 #include "Matrix.h"
+#include "DiskMatrix.h"
+#include "TaskGraph.h"
+#include "AsyncGemm.h"
+#include "LinearSolve.h"
+#include "MatrixChain.h"
+#include "MatrixOps.h"
+#include "ProcessGemm.h"
+#include "PackedGemm.h"
+#include "ExecutionPolicy.h"
 
 // Global optimization flags
 bool multiThreading    = false;
@@ -30,6 +58,61 @@ unsigned int rows_ = 100;
 unsigned int cols_ = 100;
 bool float_        = false;
 
+// Out-of-core testing variables (enabled with --ooc <budget MB>)
+bool outOfCore          = false;
+unsigned int oocBudgetMB = 0;
+
+// Page size comparison (enabled with --tlb-compare)
+bool tlbCompare = false;
+
+// Storage layout comparison (enabled with --layout morton)
+bool mortonLayout = false;
+
+// Chain pipelining comparison (enabled with --taskgraph <chain length>)
+unsigned int taskGraphChain = 0;
+
+// Asynchronous submission comparison (enabled with --async <number of products>)
+unsigned int asyncJobs = 0;
+
+// LU factorization and linear solve benchmark (enabled with --lu)
+bool luSolve = false;
+
+// Matrix chain planner benchmark (enabled with --chain <chain length>)
+unsigned int chainLength = 0;
+
+// Elementwise and reduction bandwidth benchmark (enabled with --elementwise)
+bool elementwiseOps = false;
+
+// Hints off/on comparison for the kernels given --prefetch or --stream
+bool memoryHintsSet = false;
+
+// Matrix-vector benchmark (enabled with --gemv)
+bool gemvOps = false;
+
+// Packed GEMM phase timing (enabled with --packed)
+bool packedGemm = false;
+
+// Process vs thread scaling comparison (enabled with --processes <max workers>)
+unsigned int maxProcesses = 0;
+
+// Allocation pool comparison (enabled with --pool <calls>)
+unsigned int poolCalls = 0;
+
+// Execution policy comparison (enabled with --policies)
+bool comparePolicies = false;
+
+// Function to look up the SIMD kernels named on the command line (simd, mt_simd, simd_co, maximum or all)
+std::vector<SimdKernel> parseSimdKernels(const std::string& name) {
+    const char* names[] = {"simd", "mt_simd", "simd_co", "maximum"};
+    std::vector<SimdKernel> kernels;
+    for (int k = 0; k < static_cast<int>(SimdKernel::Count); ++k) {
+        if (name == "all" || name == names[k]) {
+            kernels.push_back(static_cast<SimdKernel>(k));
+        }
+    }
+    return kernels;
+}
+
 // Function to automatically populate matrix A with random Integers
 template <typename T>
 void populateRandomInteger(Matrix<T>& A) {
@@ -60,48 +143,745 @@ void populateRandomFloat(Matrix<T>& A) {
     }  
 }
 
-// Function to execute the multiplication testing
+// Function to populate matrix A with random values of its element type
 template <typename T>
-void testExecute(Matrix<T>& A, Matrix<T>& B) {
-    // Compute the product A x B = C
-    printf("\r\n\n\tComputing product A x B = C now ... ");
-    auto startMultiply = std::chrono::high_resolution_clock::now();
+void populateRandom(Matrix<T>& A) {
+    if constexpr (std::is_floating_point_v<T>) {
+        populateRandomFloat(A);
+    } else {
+        populateRandomInteger(A);
+    }
+}
+
+// Function to dispatch the multiplication selected by the optimization flags
+template <typename T>
+Matrix<T> multiplySelected(Matrix<T>& A, Matrix<T>& B) {
     if (multiThreading && !SIMD && !cacheOptimization) {       // 1 0 0 Just MT
-        Matrix<T> result = mulMatMT(A, B);
+        return mulMatMT(A, B);
     }
     else if (!multiThreading && SIMD && !cacheOptimization) {  // 0 1 0 Just SIMD
-        Matrix<T> result = mulMatSIMD(A, B);
+        return mulMatSIMD(A, B);
     }
     else if (!multiThreading && !SIMD && cacheOptimization) {  // 0 0 1Just cacheOp
-        Matrix<T> result = mulMatCO(A, B);
+        return mulMatCO(A, B);
     } 
     else if (multiThreading && SIMD && !cacheOptimization) {   // 1 1 0 MT & SIMD
-        Matrix<T> result = mulMatMT_SIMD(A, B);
+        return mulMatMT_SIMD(A, B);
     }
     else if (!multiThreading && SIMD && cacheOptimization) {   // 0 1 1 SIMD & cacheOp
-        Matrix<T> result = mulMatSIMD_CO(A, B);
+        return mulMatSIMD_CO(A, B);
     }
     else if (multiThreading && !SIMD && cacheOptimization) {   // 1 0 1 MT & CacheOp
-        Matrix<T> result = mulMatMT_CO(A, B);
+        return mulMatMT_CO(A, B);
     }
     else if (multiThreading && SIMD && cacheOptimization) {    // 1 1 1 MAXIMUM POWER!
-        Matrix<T> result = mulMatMAXIMUM(A, B);
+        return mulMatMAXIMUM(A, B);
     }
     else {                                                     // 0 0 0 Zero ops. Naive.
-        Matrix<T> result = mulMatNAIVE(A, B);
+        return mulMatNAIVE(A, B);
     }
+}
+
+// Function to execute the multiplication testing
+template <typename T>
+void testExecute(Matrix<T>& A, Matrix<T>& B) {
+    // Compute the product A x B = C
+    printf("\r\n\n\tComputing product A x B = C now ... ");
+    auto startMultiply = std::chrono::high_resolution_clock::now();
+    Matrix<T> result = multiplySelected(A, B);
     auto stopMultiply = std::chrono::high_resolution_clock::now();
     auto durationMultiply = std::chrono::duration_cast<std::chrono::microseconds>
         (stopMultiply - startMultiply);
-    printf("\r\n\n\tMatrices multiplied. Elapsed time: %.6f seconds.",
-        static_cast<double>(durationMultiply.count()) / 1000000);
+    double seconds = static_cast<double>(durationMultiply.count()) / 1000000;
+    printf("\r\n\n\tMatrices multiplied. Elapsed time: %.6f seconds.", seconds);
+    printf("\r\n\t Throughput: %.2f GFLOPS", 2.0 * A.numRows() * A.numCols() * B.numCols() / seconds / 1e9);
+    printf("\r\n\n\t");
+}
+
+// Function to time each SIMD kernel that has memory hints set, once with the hints off and once on
+template <typename T>
+void testMemoryHints(Matrix<T>& A, Matrix<T>& B) {
+    if constexpr (!std::is_same_v<T, int>) {
+        printf("\r\n\n\tThe SIMD kernels are 8-lane int32; compare memory hints on int matrices.\r\n\n\t");
+    } else {
+        if (B.numCols() % 8 != 0) {
+            printf("\r\n\n\tThe SIMD kernels need a multiple of 8 columns to compare memory hints.\r\n\n\t");
+            return;
+        }
+        printf("\r\n\n\tMemory hints off vs on, per kernel (best of 3 runs each):");
+        size_t mismatches = 0;
+        for (int k = 0; k < static_cast<int>(SimdKernel::Count); ++k) {
+            SimdKernel kernel = static_cast<SimdKernel>(k);
+            MemoryHints hints = memoryHints(kernel);
+            if (!hints.prefetchDistance && !hints.streamStores) {
+                continue;
+            }
+            auto multiply = [&]() -> Matrix<T> {
+                switch (kernel) {
+                    case SimdKernel::SIMD:    return mulMatSIMD(A, B);
+                    case SimdKernel::MT_SIMD: return mulMatMT_SIMD(A, B);
+                    case SimdKernel::SIMD_CO: return mulMatSIMD_CO(A, B);
+                    default:                  return mulMatMAXIMUM(A, B);
+                }
+            };
+            double best[2] = {1e30, 1e30};
+            Matrix<T> results[2] = {Matrix<T>(0, 0), Matrix<T>(0, 0)};
+            for (int on = 0; on < 2; ++on) {
+                memoryHints(kernel) = on ? hints : MemoryHints{}; // The table entry is what the kernel reads
+                for (int rep = 0; rep < 3; ++rep) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    results[on] = multiply();
+                    best[on] = std::min(best[on], std::chrono::duration<double>(
+                        std::chrono::high_resolution_clock::now() - start).count());
+                }
+            }
+            memoryHints(kernel) = hints;
+            for (size_t i = 0; i < A.numRows(); ++i) {
+                for (size_t j = 0; j < B.numCols(); ++j) {
+                    mismatches += (results[0](i, j) != results[1](i, j)); // Hints must not change the result
+                }
+            }
+            printf("\r\n\n\t %s (prefetch distance = %u, streaming stores = %s)", simdKernelName(kernel),
+                hints.prefetchDistance, hints.streamStores ? "above LLC size" : "off");
+            printf("\r\n\t  hints off: %.6f seconds", best[0]);
+            printf("\r\n\t  hints on:  %.6f seconds (%.2fx)", best[1], best[0] / best[1]);
+        }
+        printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+        printf("\r\n\n\t");
+    }
+}
+
+// Function to run the selected multiplication with 4 KB and then 2 MB backed buffers
+template <typename T>
+void testTLBCompare(Matrix<T>& A, Matrix<T>& B) {
+    printf("\r\n\n\tComparing 4 KB and 2 MB page backing (buffers >= %u KB) ...",
+        static_cast<size_t>(HugePagePolicy::thresholdBytes / 1024));
+    double baseline = 0;
+    for (bool huge : {false, true}) {
+        // Backing is decided at allocation, so copy the operands under the new policy
+        HugePagePolicy::enabled = huge;
+        Matrix<T> A2 = A;
+        Matrix<T> B2 = B;
+        PerfCounter tlbMisses(PerfEvent::DTLBLoadMisses);
+        auto startMultiply = std::chrono::high_resolution_clock::now();
+        tlbMisses.start();
+        Matrix<T> result = multiplySelected(A2, B2);
+        long long misses = tlbMisses.stop();
+        auto stopMultiply = std::chrono::high_resolution_clock::now();
+        double elapsed = std::chrono::duration<double>(stopMultiply - startMultiply).count();
+        printf("\r\n\n\t %s backing (%s)", huge ? "2 MB" : "4 KB", pageBackingName(A2.pageBacking()));
+        printf("\r\n\t  elapsed time = %.6f seconds", elapsed);
+        if (misses >= 0) {
+            printf("\r\n\t  dTLB load misses = %lld", misses);
+        } else {
+            printf("\r\n\t  dTLB load misses = unavailable (perf_event_open denied)");
+        }
+        if (huge) {
+            printf("\r\n\n\t Speedup from huge pages: %.2fx", baseline / elapsed);
+        } else {
+            baseline = elapsed;
+        }
+    }
+    HugePagePolicy::enabled = true;
     printf("\r\n\n\t");
 }
 
-main(int argc, char* argv[]) {
+// Function to time one multiplication while counting last-level cache traffic
+template <typename F>
+void measureCacheMisses(const char* label, F multiply) {
+    PerfCounter llcLoads(PerfEvent::LLCLoads);
+    PerfCounter llcMisses(PerfEvent::LLCLoadMisses);
+    auto start = std::chrono::high_resolution_clock::now();
+    llcLoads.start();
+    llcMisses.start();
+    multiply();
+    long long misses = llcMisses.stop();
+    long long loads = llcLoads.stop();
+    auto stop = std::chrono::high_resolution_clock::now();
+    printf("\r\n\n\t %s", label);
+    printf("\r\n\t  elapsed time = %.6f seconds", std::chrono::duration<double>(stop - start).count());
+    if (misses >= 0 && loads >= 0) {
+        printf("\r\n\t  LLC loads = %lld, LLC load misses = %lld", loads, misses);
+    } else {
+        printf("\r\n\t  LLC counters unavailable (perf_event_open denied)");
+    }
+}
+
+// Function to compare the row-major blocked kernel with the recursive Morton kernel
+template <typename T>
+void testLayoutCompare(Matrix<T>& A, Matrix<T>& B) {
+    constexpr size_t tile = 32;
+    printf("\r\n\n\tComparing row-major and Morton (%u x %u tiles) layouts ...", tile, tile);
+
+    Matrix<T> rowMajorResult(0, 0);
+    measureCacheMisses("Row-major, blocked (mulMatBlocked)", [&] {
+        rowMajorResult = mulMatBlocked(A, B);
+    });
+
+    auto startConvert = std::chrono::high_resolution_clock::now();
+    Matrix<T, MortonTiled<tile>> mortonA = toMorton<tile>(A);
+    Matrix<T, MortonTiled<tile>> mortonB = toMorton<tile>(B);
+    auto stopConvert = std::chrono::high_resolution_clock::now();
+    printf("\r\n\n\t Converted A and B to Morton layout. Elapsed time: %.6f seconds.",
+        std::chrono::duration<double>(stopConvert - startConvert).count());
+
+    Matrix<T, MortonTiled<tile>> mortonResult(0, 0);
+    measureCacheMisses("Morton, cache-oblivious recursive (mulMatMorton)", [&] {
+        mortonResult = mulMatMorton(mortonA, mortonB);
+    });
+
+    // Check the two kernels agree
+    Matrix<T> converted = toRowMajor(mortonResult);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < converted.numRows(); ++i) {
+        for (size_t j = 0; j < converted.numCols(); ++j) {
+            T expected = rowMajorResult(i, j);
+            if (std::abs(converted(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                ++mismatches;
+            }
+        }
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to compare a fork-join chain product with the pipelined coroutine task graph
+template <typename T>
+void testTaskGraph(Matrix<T>& A, Matrix<T>& B) {
+    // Alternate A and B to form a chain of the requested length
+    std::vector<Matrix<T>> chain;
+    for (size_t m = 0; m < taskGraphChain; ++m) {
+        chain.push_back((m % 2 == 0) ? A : B);
+    }
+    printf("\r\n\n\tMultiplying a chain of %u matrices ...", taskGraphChain);
+
+    // Fork-join: every product is a barrier before the next one may start
+    auto startForkJoin = std::chrono::high_resolution_clock::now();
+    Matrix<T> forkJoin = chain[0];
+    for (size_t m = 1; m < chain.size(); ++m) {
+        forkJoin = mulMatBlocked(forkJoin, chain[m]);
+    }
+    auto stopForkJoin = std::chrono::high_resolution_clock::now();
+    printf("\r\n\n\t Fork-join (mulMatBlocked per product) elapsed time: %.6f seconds.",
+        std::chrono::duration<double>(stopForkJoin - startForkJoin).count());
+
+    // Task graph: tiles of each product flow straight into the next one
+    auto startGraph = std::chrono::high_resolution_clock::now();
+    Matrix<T> pipelined = mulChainTaskGraph(chain);
+    auto stopGraph = std::chrono::high_resolution_clock::now();
+    printf("\r\n\t Task graph (mulChainTaskGraph) elapsed time: %.6f seconds.",
+        std::chrono::duration<double>(stopGraph - startGraph).count());
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < pipelined.numRows(); ++i) {
+        for (size_t j = 0; j < pipelined.numCols(); ++j) {
+            T expected = forkJoin(i, j);
+            if (std::abs(pipelined(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                ++mismatches;
+            }
+        }
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to compare blocking products with products submitted through mulMatAsync
+template <typename T>
+void testAsync(Matrix<T>& A, Matrix<T>& B) {
+    printf("\r\n\n\tComputing %u independent products A x B ...", asyncJobs);
+
+    // Blocking: the calling thread is stuck in each join loop in turn
+    auto startBlocking = std::chrono::high_resolution_clock::now();
+    for (size_t job = 0; job < asyncJobs; ++job) {
+        Matrix<T> result = mulMatBlocked(A, B);
+    }
+    auto stopBlocking = std::chrono::high_resolution_clock::now();
+    printf("\r\n\n\t Blocking (mulMatBlocked) elapsed time: %.6f seconds.",
+        std::chrono::duration<double>(stopBlocking - startBlocking).count());
+
+    // Asynchronous: submit everything, the calling thread stays free until it asks for results
+    auto startAsync = std::chrono::high_resolution_clock::now();
+    std::vector<std::future<Matrix<T>>> futures;
+    for (size_t job = 0; job < asyncJobs; ++job) {
+        futures.push_back(mulMatAsync(A, B));
+    }
+    auto submitted = std::chrono::high_resolution_clock::now();
+    GemmServiceReport inFlight = defaultGemmService().report();
+    for (auto& future : futures) {
+        Matrix<T> result = future.get();
+    }
+    auto stopAsync = std::chrono::high_resolution_clock::now();
+    GemmServiceReport report = defaultGemmService().report();
+
+    printf("\r\n\t Asynchronous (mulMatAsync) elapsed time: %.6f seconds.",
+        std::chrono::duration<double>(stopAsync - startAsync).count());
+    printf("\r\n\t  time to submit all products = %.6f seconds",
+        std::chrono::duration<double>(submitted - startAsync).count());
+    printf("\r\n\t  queue depth after submitting = %u (max %u)", inFlight.queueDepth, report.maxQueueDepth);
+    printf("\r\n\t  mean queue wait = %.3f ms", report.meanWaitMs);
+    printf("\r\n\t  latency mean = %.3f ms, max = %.3f ms", report.meanLatencyMs, report.maxLatencyMs);
+    printf("\r\n\n\t");
+}
+
+// Function to benchmark blocked LU factorization and solve against the multiply kernels
+template <typename T>
+void testLinearSolve(Matrix<T>& A, Matrix<T>& B) {
+    if constexpr (!std::is_floating_point_v<T>) {
+        printf("\r\n\n\tLU factorization requires matrix type float.\r\n\n\t");
+    } else {
+        double n = static_cast<double>(A.numRows());
+
+        // Reference: the GEMM kernels LU builds on
+        auto startMultiply = std::chrono::high_resolution_clock::now();
+        Matrix<T> product = mulMatBlocked(A, B);
+        auto stopMultiply = std::chrono::high_resolution_clock::now();
+        double multiplySeconds = std::chrono::duration<double>(stopMultiply - startMultiply).count();
+        printf("\r\n\n\t Multiply (mulMatBlocked): %.6f seconds, %.2f GFLOPS",
+            multiplySeconds, 2.0 * n * n * n / multiplySeconds / 1e9);
+
+        // Factor (2/3 n^3 FLOPs) and solve for one right-hand side (2 n^2 FLOPs)
+        Matrix<T> b(A.numRows(), 1);
+        populateRandom(b);
+        auto startFactor = std::chrono::high_resolution_clock::now();
+        LUFactorization<T> F = factorLU(A);
+        auto stopFactor = std::chrono::high_resolution_clock::now();
+        Matrix<T> x = solveLU(F, b);
+        auto stopSolve = std::chrono::high_resolution_clock::now();
+        double factorSeconds = std::chrono::duration<double>(stopFactor - startFactor).count();
+        double solveSeconds = std::chrono::duration<double>(stopSolve - stopFactor).count();
+        printf("\r\n\t LU factorization (factorLU): %.6f seconds, %.2f GFLOPS",
+            factorSeconds, (2.0 / 3.0) * n * n * n / factorSeconds / 1e9);
+        printf("\r\n\t Triangular solves (solveLU): %.6f seconds, %.2f GFLOPS",
+            solveSeconds, 2.0 * n * n / solveSeconds / 1e9);
+
+        // Relative residual ||Ax - b|| / ||b||
+        double residual = 0;
+        double norm = 0;
+        for (size_t i = 0; i < A.numRows(); ++i) {
+            double r = -b(i, 0);
+            for (size_t j = 0; j < A.numCols(); ++j) {
+                r += static_cast<double>(A(i, j)) * x(j, 0);
+            }
+            residual += r * r;
+            norm += static_cast<double>(b(i, 0)) * b(i, 0);
+        }
+        printf("\r\n\t Relative residual ||Ax - b|| / ||b|| = %.3e", std::sqrt(residual / norm));
+        printf("\r\n\n\t");
+    }
+}
+
+// Function to compare the planned chain order with plain left-to-right evaluation
+template <typename T>
+void testMatrixChain(Matrix<T>& A, Matrix<T>&) {
+    // Random shapes between size/8 and size, so the order actually matters
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<unsigned int> dist(std::max(1u, A.numRows() / 8), A.numRows());
+    std::vector<size_t> dims;
+    for (size_t m = 0; m <= chainLength; ++m) {
+        dims.push_back(dist(gen));
+    }
+    std::vector<Matrix<T>> chain;
+    printf("\r\n\n\tMultiplying a chain of %u matrices:", chainLength);
+    for (size_t m = 0; m < chainLength; ++m) {
+        chain.emplace_back(dims[m], dims[m + 1]);
+        populateRandom(chain.back());
+        printf(" %ux%u", dims[m], dims[m + 1]);
+    }
+
+    // Calibrate first so the one-off kernel timing is not charged to the planned run
+    const GemmCostModel& model = calibratedGemmCostModel<T>();
+    printf("\r\n\n\t Cost model: %.2f GFLOPS sustained, %.3f ms per call",
+        model.flopsPerSecond / 1e9, model.overheadSeconds * 1e3);
+
+    // Left to right: ((M0 M1) M2) ...
+    auto startNaive = std::chrono::high_resolution_clock::now();
+    Matrix<T> naive = chain[0];
+    for (size_t m = 1; m < chain.size(); ++m) {
+        naive = mulMatBlocked(naive, chain[m]);
+    }
+    auto stopNaive = std::chrono::high_resolution_clock::now();
+
+    // Planned order, independent sub-products concurrently
+    ChainPlan plan;
+    auto startPlanned = std::chrono::high_resolution_clock::now();
+    Matrix<T> planned = multiplyChain(chain, &plan);
+    auto stopPlanned = std::chrono::high_resolution_clock::now();
+
+    printf("\r\n\n\t Planned order: %s", chainOrderString(plan, 0, chain.size() - 1).c_str());
+    printf("\r\n\n\t Left to right: %.3f GFLOP, predicted %.6f s, elapsed time %.6f seconds.",
+        plan.naiveFlops / 1e9, plan.naiveSeconds, std::chrono::duration<double>(stopNaive - startNaive).count());
+    printf("\r\n\t Planned (multiplyChain): %.3f GFLOP, predicted %.6f s, elapsed time %.6f seconds.",
+        plan.plannedFlops / 1e9, plan.plannedSeconds,
+        std::chrono::duration<double>(stopPlanned - startPlanned).count());
+    printf("\r\n\t FLOP reduction = %.2fx", plan.naiveFlops / plan.plannedFlops);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < planned.numRows(); ++i) {
+        for (size_t j = 0; j < planned.numCols(); ++j) {
+            T expected = naive(i, j);
+            if (std::abs(planned(i, j) - expected) > std::abs(expected) * T(1e-3)) {
+                ++mismatches;
+            }
+        }
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to time one memory-bound operation (best of several runs) and report GB/s
+template <typename F>
+void measureBandwidth(const char* label, double bytes, F operation) {
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        auto start = std::chrono::high_resolution_clock::now();
+        operation();
+        auto stop = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    printf("\r\n\t %-28s %.6f seconds, %7.2f GB/s", label, best, bytes / best / 1e9);
+}
+
+// Function to benchmark the elementwise operations and reductions in GB/s and check them against scalar loops
+template <typename T>
+void testElementwise(Matrix<T>& A, Matrix<T>& B) {
+    double n = static_cast<double>(A.numRows()) * A.numCols();
+    double matrixBytes = n * sizeof(T);
+    printf("\r\n\n\tElementwise operations and reductions (best of 5, bytes read + written):");
+    Matrix<T> sum(0, 0), scaled(0, 0), product(0, 0), rows(0, 0), cols(0, 0);
+    measureBandwidth("add (addMat)", 3 * matrixBytes, [&] { sum = addMat(A, B); });
+    measureBandwidth("scale (scaleMat)", 2 * matrixBytes, [&] { scaled = scaleMat(A, T(3)); });
+    measureBandwidth("Hadamard (hadamardMat)", 3 * matrixBytes, [&] { product = hadamardMat(A, B); });
+    measureBandwidth("row sums (rowSums)", matrixBytes, [&] { rows = rowSums(A); });
+    measureBandwidth("column sums (colSums)", matrixBytes, [&] { cols = colSums(A); });
+    double frobenius = 0;
+    double maximum = 0;
+    measureBandwidth("Frobenius norm", matrixBytes, [&] { frobenius = frobeniusNorm(A); });
+    measureBandwidth("max norm", matrixBytes, [&] { maximum = maxNorm(A); });
+    printf("\r\n\n\t ||A||_F = %.6e, max |a_ij| = %.6e", frobenius, maximum);
+
+    // Scalar references (sums in double; float sums may differ in the last bits from lane order)
+    size_t mismatches = 0;
+    auto differs = [](double value, double expected) {
+        return std::abs(value - expected) > std::abs(expected) * 1e-4;
+    };
+    std::vector<double> expectedCols(A.numCols(), 0.0);
+    double expectedSquares = 0;
+    double expectedMax = 0;
+    for (size_t i = 0; i < A.numRows(); ++i) {
+        double expectedRow = 0;
+        for (size_t j = 0; j < A.numCols(); ++j) {
+            T a = A(i, j);
+            T b = B(i, j);
+            mismatches += (sum(i, j) != a + b) + (scaled(i, j) != T(3) * a) + (product(i, j) != a * b);
+            expectedRow += a;
+            expectedCols[j] += a;
+            expectedSquares += static_cast<double>(a) * a;
+            expectedMax = std::max(expectedMax, std::abs(static_cast<double>(a)));
+        }
+        mismatches += differs(rows(i, 0), expectedRow);
+    }
+    for (size_t j = 0; j < A.numCols(); ++j) {
+        mismatches += differs(cols(0, j), expectedCols[j]);
+    }
+    mismatches += differs(frobenius, std::sqrt(expectedSquares)) + (maximum != expectedMax);
+    if constexpr (std::is_same_v<T, int>) {
+        // |INT_MIN| does not fit an int, so the SIMD lanes must not report it as negative
+        Matrix<int> extreme(1, 16);
+        extreme(0, 3) = std::numeric_limits<int>::min();
+        mismatches += (maxNorm(extreme) != 2147483648.0);
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to benchmark GEMV (A x) and GEVM (x A) in GB/s and check them against scalar loops
+template <typename T>
+void testGemv(Matrix<T>& A, Matrix<T>&) {
+    Matrix<T> column(A.numCols(), 1);
+    Matrix<T> row(1, A.numRows());
+    populateRandom(column);
+    populateRandom(row);
+    double matrixBytes = static_cast<double>(A.numRows()) * A.numCols() * sizeof(T);
+    double vectorBytes = static_cast<double>(A.numRows() + A.numCols()) * sizeof(T);
+    printf("\r\n\n\tMatrix-vector products (best of 5, A read once + x + y):");
+    Matrix<T> y(0, 0);
+    Matrix<T> z(0, 0);
+    measureBandwidth("GEMV y = A x (mulMatVec)", matrixBytes + vectorBytes, [&] { y = mulMatVec(A, column); });
+    measureBandwidth("GEVM y = x A (mulVecMat)", matrixBytes + vectorBytes, [&] { z = mulVecMat(row, A); });
+
+    size_t mismatches = 0;
+    std::vector<double> expectedRow(A.numCols(), 0.0);
+    for (size_t i = 0; i < A.numRows(); ++i) {
+        double expected = 0;
+        for (size_t j = 0; j < A.numCols(); ++j) {
+            expected += static_cast<double>(A(i, j)) * column(j, 0);
+            expectedRow[j] += static_cast<double>(row(0, i)) * A(i, j);
+        }
+        mismatches += std::abs(y(i, 0) - expected) > std::abs(expected) * 1e-3;
+    }
+    for (size_t j = 0; j < A.numCols(); ++j) {
+        mismatches += std::abs(z(0, j) - expectedRow[j]) > std::abs(expectedRow[j]) * 1e-3;
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to compare single- and double-buffered B packing, with per-phase timers
+template <typename T>
+void testPacked(Matrix<T>& A, Matrix<T>& B) {
+    double flops = 2.0 * A.numRows() * A.numCols() * B.numCols();
+    auto startBlocked = std::chrono::high_resolution_clock::now();
+    Matrix<T> reference = mulMatBlocked(A, B);
+    double blocked = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startBlocked).count();
+    printf("\r\n\n\t Unpacked (mulMatBlocked): %.6f seconds, %.2f GFLOPS", blocked, flops / blocked / 1e9);
+
+    size_t mismatches = 0;
+    for (bool overlap : {false, true}) {
+        PackedGemmStats stats;
+        Matrix<T> result = mulMatPacked(A, B, &stats, overlap);
+        printf("\r\n\n\t Packed, %s (mulMatPacked): %.6f seconds, %.2f GFLOPS",
+            overlap ? "double-buffered B" : "single-buffered B", stats.totalSeconds, flops / stats.totalSeconds / 1e9);
+        printf("\r\n\t  %u compute threads + 1 packing thread, %u K panels, %.1f KB of arenas",
+            stats.computeThreads, stats.panels, stats.arenaBytes / 1024.0);
+        printf("\r\n\t  pack B (helper) = %.6f s", stats.packBSeconds);
+        printf("\r\n\t  pack A = %.6f s, compute = %.6f s, barrier wait = %.6f s (summed over threads)",
+            stats.packASeconds, stats.computeSeconds, stats.waitSeconds);
+        for (size_t i = 0; i < result.numRows(); ++i) {
+            for (size_t j = 0; j < result.numCols(); ++j) {
+                T expected = reference(i, j);
+                if (std::abs(result(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to compare scaling of the multi-process GEMM against threads on the same tiles
+template <typename T>
+void testProcesses(Matrix<T>& A, Matrix<T>& B) {
+    Matrix<T> reference = mulMatBlocked(A, B);
+    printf("\r\n\n\tScaling C = A x B over worker processes (POSIX shm + UNIX sockets) and threads ...");
+    printf("\r\n\n\t workers  processes (s)  setup (s)  copy-out (s)  speedup   threads (s)  speedup");
+    double processBase = 0;
+    double threadBase = 0;
+    size_t mismatches = 0;
+    for (size_t workers = 1; workers <= maxProcesses; workers = (workers * 2 > maxProcesses && workers < maxProcesses)
+                                                               ? maxProcesses : workers * 2) {
+        Matrix<T> C(A.numRows(), B.numCols());
+        ProcessGemmStats processes = mulMatProcesses(A, B, C, workers);
+        Matrix<T> D(A.numRows(), B.numCols());
+        ProcessGemmStats threads = mulMatTileThreads(A, B, D, workers);
+        if (workers == 1) {
+            processBase = processes.computeSeconds;
+            threadBase = threads.computeSeconds;
+        }
+        printf("\r\n\t %7u  %13.6f  %9.6f  %12.6f  %6.2fx  %12.6f  %6.2fx", workers,
+            processes.computeSeconds, processes.setupSeconds, processes.copyOutSeconds,
+            processBase / processes.computeSeconds, threads.computeSeconds, threadBase / threads.computeSeconds);
+        for (size_t i = 0; i < C.numRows(); ++i) {
+            for (size_t j = 0; j < C.numCols(); ++j) {
+                T expected = reference(i, j);
+                if (std::abs(C(i, j) - expected) > std::abs(expected) * T(1e-4) ||
+                    std::abs(D(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to compare repeated multiplications with and without the buffer pool and zero fill
+//  Every call allocates its result (and the kernels their scratch copies); the counters show
+//  how much of that memory was fresh, how much was zeroed and how many pages faulted in.
+template <typename T>
+void testPool(Matrix<T>& A, Matrix<T>& B) {
+    struct PoolConfig {
+        const char* name;
+        bool pooled;
+        bool skipZeroFill;
+    };
+    const PoolConfig configs[] = {
+        {"fresh, always zeroed", false, false},
+        {"fresh, zero fill skipped", false, true},
+        {"pooled, always zeroed", true, false},
+        {"pooled, zero fill skipped", true, true},
+    };
+    Matrix<T> reference = multiplySelected(A, B);
+    printf("\r\n\n\t%u calls of the selected multiplication per configuration (per-call averages) ...", poolCalls);
+    printf("\r\n\n\t %-26s %11s %10s %10s %10s %9s %12s", "configuration", "time (s)",
+        "alloc KB", "fresh KB", "zeroed KB", "pool hits", "page faults");
+    size_t mismatches = 0;
+    for (const PoolConfig& config : configs) {
+        MatrixPool pool; // Declared first so it outlives every buffer drawn from it
+        BufferPolicy policy{config.pooled ? &pool : nullptr, config.skipZeroFill};
+        // The kernels allocate under their first operand's policy, so give A's copy this one
+        Matrix<T> operandA(A.numRows(), A.numCols(), BufferInit::Uninitialized, policy);
+        std::copy(A.storage(), A.storage() + 1ull * A.numRows() * A.numCols(), operandA.storage());
+        if (config.pooled) {
+            // Pre-fault one result-sized block plus one for a transposed copy of B
+            unsigned long long bytes = 1ull * A.numRows() * B.numCols() * sizeof(T);
+            pool.reserve(bytes, 1);
+            pool.reserve(1ull * B.numRows() * B.numCols() * sizeof(T), 1);
+        }
+        AllocationScope scope;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (unsigned int call = 0; call < poolCalls; ++call) {
+            Matrix<T> result = multiplySelected(operandA, B);
+            if (call + 1 == poolCalls) {
+                for (size_t i = 0; i < result.numRows(); ++i) {
+                    for (size_t j = 0; j < result.numCols(); ++j) {
+                        T expected = reference(i, j);
+                        if (std::abs(result(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                            ++mismatches;
+                        }
+                    }
+                }
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        AllocationReport report = scope.report();
+        printf("\r\n\t %-26s %11.6f %10.1f %10.1f %10.1f %9.1f %12.1f", config.name, seconds / poolCalls,
+            report.bytesRequested / 1024.0 / poolCalls, report.bytesFresh / 1024.0 / poolCalls,
+            report.bytesZeroed / 1024.0 / poolCalls, double(report.poolHits) / poolCalls,
+            double(report.minorFaults + report.majorFaults) / poolCalls);
+    }
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to time the same GEMM and add kernels under each execution policy
+template <typename T, typename Policy>
+void benchmarkPolicy(const Policy& policy, Matrix<T>& A, Matrix<T>& B, Matrix<T>& reference, size_t& mismatches) {
+    double flops = 2.0 * A.numRows() * A.numCols() * B.numCols();
+    printf("\r\n\n\t %s", Policy::name);
+    auto timeGemm = [&](const char* label, auto kernel) {
+        auto start = std::chrono::high_resolution_clock::now();
+        Matrix<T> result = kernel();
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        printf("\r\n\t %-28s %.6f seconds, %7.2f GFLOPS", label, seconds, flops / seconds / 1e9);
+        for (size_t i = 0; i < result.numRows(); ++i) {
+            for (size_t j = 0; j < result.numCols(); ++j) {
+                T expected = reference(i, j);
+                if (std::abs(result(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                    ++mismatches;
+                }
+            }
+        }
+    };
+    timeGemm(" GEMM blocked:", [&] { return mulMatBlockedWith(policy, A, B); });
+    timeGemm(" GEMM naive:", [&] { return mulMatNaiveWith(policy, A, B); });
+    timeGemm(" GEMM transposed (CO):", [&] { return mulMatTransposedWith(policy, A, B); });
+    timeGemm(" GEMM packed:", [&] { return mulMatPackedWith(policy, A, B); });
+    if constexpr (std::is_same_v<T, int>) { // The SIMD kernels are 8-lane int32
+        if (B.numCols() % 8 == 0) {
+            timeGemm(" GEMM SIMD:", [&] { return mulMatSIMDWith(policy, A, B); });
+            timeGemm(" GEMM transposed SIMD:", [&] { return mulMatTransposedSIMDWith(policy, A, B); });
+        }
+    }
+    double matrixBytes = static_cast<double>(A.numRows()) * A.numCols() * sizeof(T);
+    Matrix<T> sum(0, 0);
+    measureBandwidth(" add:", 3 * matrixBytes, [&] { sum = addMatWith(policy, A, B); });
+    for (size_t i = 0; i < sum.numRows(); ++i) {
+        for (size_t j = 0; j < sum.numCols(); ++j) {
+            if (sum(i, j) != A(i, j) + B(i, j)) {
+                ++mismatches;
+            }
+        }
+    }
+}
+
+// Function to compare hand-rolled threads with the standard and pooled execution policies
+template <typename T>
+void testPolicies(Matrix<T>& A, Matrix<T>& B) {
+    Matrix<T> reference = mulMatBlocked(A, B);
+    printf("\r\n\n\tOne kernel body per execution policy (%u hardware threads):", std::thread::hardware_concurrency());
+    size_t mismatches = 0;
+    benchmarkPolicy(SequentialExecution{}, A, B, reference, mismatches);
+    benchmarkPolicy(ThreadSplitExecution{}, A, B, reference, mismatches);
+#ifdef MATTEST_PARALLEL_STL
+    benchmarkPolicy(ParallelUnseqExecution{}, A, B, reference, mismatches);
+#else
+    printf("\r\n\n\t %s: not built (compile with -DMATTEST_PARALLEL_STL and link -ltbb)", "std::execution::par_unseq");
+#endif
+    GemmService pool;
+    benchmarkPolicy(PoolExecution{pool}, A, B, reference, mismatches);
+    printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    printf("\r\n\n\t");
+}
+
+// Function to execute the out-of-core multiplication testing (A, B and C live on disk)
+template <typename T>
+void testOutOfCore() {
+    // Write A and B to disk one strip of rows at a time, so they never have to fit in DRAM
+    printf("\r\n\n\tWriting random %d x %d matrices A and B to disk ...", rows_, cols_);
+    auto startPopulate = std::chrono::high_resolution_clock::now();
+    DiskMatrix<T> A("ooc_A.bin", rows_, cols_, true);
+    DiskMatrix<T> B("ooc_B.bin", rows_, cols_, true);
+    DiskMatrix<T> C("ooc_C.bin", rows_, cols_, true);
+    unsigned long long budgetBytes = oocBudgetMB * 1048576ull;
+    size_t stripRows = static_cast<size_t>(std::min<unsigned long long>(rows_, budgetBytes / (2ull * cols_ * sizeof(T))));
+    stripRows = std::max(1u, stripRows);
+    Matrix<T> strip(stripRows, cols_);
+    for (size_t row = 0; row < rows_; row += stripRows) {
+        size_t h = std::min(stripRows, rows_ - row);
+        for (DiskMatrix<T>* M : {&A, &B}) {
+            populateRandom(strip);
+            M->writeTile(row, 0, h, cols_, strip);
+        }
+    }
+    auto stopPopulate = std::chrono::high_resolution_clock::now();
+    auto durationPopulate = std::chrono::duration_cast<std::chrono::microseconds>
+        (stopPopulate - startPopulate);
+    printf("\r\n\n\tMatrices written. Elapsed time: %.6f seconds.",
+        static_cast<double>(durationPopulate.count()) / 1000000);
+
+    // Compute the product A x B = C, streaming tiles through the budget
+    printf("\r\n\n\tComputing out-of-core product A x B = C now (budget %u MB) ... ", oocBudgetMB);
+    OutOfCoreStats stats = mulMatOutOfCore(A, B, C, budgetBytes);
+    printf("\r\n\n\tMatrices multiplied. Elapsed time: %.6f seconds.", stats.totalSeconds);
+    printf("\r\n\t tile size = %u x %u (%.1f MB resident)",
+        stats.tileSize, stats.tileSize, stats.residentBytes / 1048576.0);
+    printf("\r\n\t compute time = %.6f seconds", stats.computeSeconds);
+    printf("\r\n\t I/O stall time = %.6f seconds (%.1f%% of total)",
+        stats.ioStallSeconds, 100.0 * stats.ioStallSeconds / stats.totalSeconds);
+    printf("\r\n\t bytes read = %.1f MB, bytes written = %.1f MB",
+        stats.bytesRead / 1048576.0, stats.bytesWritten / 1048576.0);
+
+    // Check C against the in-memory blocked product when all three matrices fit comfortably
+    if (rows_ <= 2048) {
+        Matrix<T> inA(rows_, cols_), inB(rows_, cols_), inC(rows_, cols_);
+        A.readTile(0, 0, rows_, cols_, inA);
+        B.readTile(0, 0, rows_, cols_, inB);
+        C.readTile(0, 0, rows_, cols_, inC);
+        Matrix<T> reference = mulMatBlocked(inA, inB);
+        size_t mismatches = 0;
+        for (size_t i = 0; i < rows_; ++i) {
+            for (size_t j = 0; j < cols_; ++j) {
+                T expected = reference(i, j);
+                if (std::abs(inC(i, j) - expected) > std::abs(expected) * T(1e-4)) {
+                    ++mismatches;
+                }
+            }
+        }
+        printf("\r\n\n\t Results %s (%u mismatching elements).", mismatches == 0 ? "match" : "DIFFER", mismatches);
+    }
+    printf("\r\n\n\t");
+}
+
+int main(int argc, char* argv[]) {
     if (argc < 6) { // Ensure correct commandline arguments
         std::cerr << "Usage: " << argv[0] << " <multithreading [1/0]> <simd [1/0]> "
-            "<cache optimization [1/0]> <matrix type [int/float]> <matrix size [100-10000]>" << std::endl;
+            "<cache optimization [1/0]> <matrix type [int/float]> <matrix size [100-10000]>"
+            " [--ooc <memory budget MB>] [--tlb-compare] [--layout morton]"
+            " [--taskgraph <chain length>] [--async <products>]"
+            " [--lu] [--chain <chain length>] [--prefetch <kernel> <distance>]"
+            " [--stream <kernel>] [--elementwise] [--processes <max workers>]"
+            " [--gemv] [--packed] [--pool <calls>] [--policies]" << std::endl;
         return 1;   // Return an error code
     }
     // Assign command line parameters to global flags
@@ -112,6 +892,53 @@ main(int argc, char* argv[]) {
         float_ = true;
     }
     rows_ = cols_ = std::stoi(argv[5]);
+    // Optional trailing flags
+    for (int i = 6; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--ooc" && i + 1 < argc) {
+            outOfCore = true;
+            oocBudgetMB = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (flag == "--tlb-compare") {
+            tlbCompare = true;
+        } else if (flag == "--layout" && i + 1 < argc && std::string(argv[i + 1]) == "morton") {
+            mortonLayout = true;
+            ++i;
+        } else if (flag == "--taskgraph" && i + 1 < argc) {
+            taskGraphChain = std::max(2, std::stoi(argv[++i]));
+        } else if (flag == "--async" && i + 1 < argc) {
+            asyncJobs = std::max(1, std::stoi(argv[++i]));
+        } else if (flag == "--lu") {
+            luSolve = true;
+        } else if (flag == "--chain" && i + 1 < argc) {
+            chainLength = std::max(2, std::stoi(argv[++i]));
+        } else if (flag == "--processes" && i + 1 < argc) {
+            maxProcesses = std::max(1, std::stoi(argv[++i]));
+        } else if (flag == "--pool" && i + 1 < argc) {
+            poolCalls = std::max(1, std::stoi(argv[++i]));
+        } else if (flag == "--policies") {
+            comparePolicies = true;
+        } else if (flag == "--packed") {
+            packedGemm = true;
+        } else if (flag == "--gemv") {
+            gemvOps = true;
+        } else if (flag == "--elementwise") {
+            elementwiseOps = true;
+        } else if (flag == "--prefetch" && i + 2 < argc && !parseSimdKernels(argv[i + 1]).empty()) {
+            for (SimdKernel kernel : parseSimdKernels(argv[i + 1])) {
+                memoryHints(kernel).prefetchDistance = std::max(0, std::stoi(argv[i + 2]));
+            }
+            memoryHintsSet = true;
+            i += 2;
+        } else if (flag == "--stream" && i + 1 < argc && !parseSimdKernels(argv[i + 1]).empty()) {
+            for (SimdKernel kernel : parseSimdKernels(argv[++i])) {
+                memoryHints(kernel).streamStores = true;
+            }
+            memoryHintsSet = true;
+        } else {
+            std::cerr << "Unknown option " << flag << std::endl;
+            return 1;
+        }
+    }
 
     // Print configuration information for testing
     printf("\r\n\tMatrix Multiplication Optimization Testing\r\n\tProgram Version 10.17.0"
@@ -124,6 +951,23 @@ main(int argc, char* argv[]) {
         cacheOptimization ? "true" : "false");
     printf("\r\n\t matrix type = %s", argv[4]);
     printf("\r\n\t matrix size = %d x %d", rows_, cols_);
+    for (int k = 0; k < static_cast<int>(SimdKernel::Count); ++k) {
+        const MemoryHints& hints = memoryHints(static_cast<SimdKernel>(k));
+        if (hints.prefetchDistance || hints.streamStores) {
+            printf("\r\n\t %s: prefetch distance = %u, streaming stores = %s (LLC %llu KB)",
+                simdKernelName(static_cast<SimdKernel>(k)), hints.prefetchDistance,
+                hints.streamStores ? "above LLC size" : "off", lastLevelCacheBytes() / 1024);
+        }
+    }
+    if (outOfCore) {
+        printf("\r\n\t outOfCore = true (budget %u MB)", oocBudgetMB);
+        if (float_) {
+            testOutOfCore<float>();
+        } else {
+            testOutOfCore<int>();
+        }
+        return 0;
+    }
 
     // Generate and populate row_ x col_ matrices for testing
     printf("\r\n\n\tGenerating random %d x %d matrices A and B ...", rows_, cols_);
@@ -139,7 +983,35 @@ main(int argc, char* argv[]) {
             (stopPopulate - startPopulate);
         printf("\r\n\n\tMatrices populated. Elapsed time: %.6f seconds.",
             static_cast<double>(durationPopulate.count()) / 1000000);
-        testExecute(A, B);             // Dispatch test execution function
+        if (tlbCompare) {
+            testTLBCompare(A, B);      // Compare page sizes instead of a single run
+        } else if (mortonLayout) {
+            testLayoutCompare(A, B);   // Compare storage layouts instead of a single run
+        } else if (taskGraphChain) {
+            testTaskGraph(A, B);       // Compare chain scheduling instead of a single run
+        } else if (asyncJobs) {
+            testAsync(A, B);           // Compare blocking and asynchronous submission
+        } else if (luSolve) {
+            testLinearSolve(A, B);     // Factor A and solve instead of multiplying
+        } else if (chainLength) {
+            testMatrixChain(A, B);     // Compare chain orders instead of a single run
+        } else if (elementwiseOps) {
+            testElementwise(A, B);     // Bandwidth of the memory-bound operations
+        } else if (maxProcesses) {
+            testProcesses(A, B);       // Process vs thread scaling
+        } else if (gemvOps) {
+            testGemv(A, B);            // Bandwidth of matrix-vector products
+        } else if (packedGemm) {
+            testPacked(A, B);          // Packing overlap and phase timers
+        } else if (poolCalls) {
+            testPool(A, B);            // Buffer recycling and zero-fill cost
+        } else if (comparePolicies) {
+            testPolicies(A, B);        // Sequential, threads, par_unseq and pool backends
+        } else if (memoryHintsSet) {
+            testMemoryHints(A, B);     // Each hinted kernel with hints off and on
+        } else {
+            testExecute(A, B);         // Dispatch test execution function
+        }
     }
     // Integer matrices being used
     else {
@@ -152,7 +1024,35 @@ main(int argc, char* argv[]) {
             (stopPopulate - startPopulate);
         printf("\r\n\n\tMatrices populated. Elapsed time: %.6f seconds.",
             static_cast<double>(durationPopulate.count()) / 1000000);
-        testExecute(A, B);             // Dispatch test execution function
+        if (tlbCompare) {
+            testTLBCompare(A, B);      // Compare page sizes instead of a single run
+        } else if (mortonLayout) {
+            testLayoutCompare(A, B);   // Compare storage layouts instead of a single run
+        } else if (taskGraphChain) {
+            testTaskGraph(A, B);       // Compare chain scheduling instead of a single run
+        } else if (asyncJobs) {
+            testAsync(A, B);           // Compare blocking and asynchronous submission
+        } else if (luSolve) {
+            testLinearSolve(A, B);     // Factor A and solve instead of multiplying
+        } else if (chainLength) {
+            testMatrixChain(A, B);     // Compare chain orders instead of a single run
+        } else if (elementwiseOps) {
+            testElementwise(A, B);     // Bandwidth of the memory-bound operations
+        } else if (maxProcesses) {
+            testProcesses(A, B);       // Process vs thread scaling
+        } else if (gemvOps) {
+            testGemv(A, B);            // Bandwidth of matrix-vector products
+        } else if (packedGemm) {
+            testPacked(A, B);          // Packing overlap and phase timers
+        } else if (poolCalls) {
+            testPool(A, B);            // Buffer recycling and zero-fill cost
+        } else if (comparePolicies) {
+            testPolicies(A, B);        // Sequential, threads, par_unseq and pool backends
+        } else if (memoryHintsSet) {
+            testMemoryHints(A, B);     // Each hinted kernel with hints off and on
+        } else {
+            testExecute(A, B);         // Dispatch test execution function
+        }
     }
     return 0;                          // Normal process return
 }
\ No newline at end of file
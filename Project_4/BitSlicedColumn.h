@@ -0,0 +1,185 @@
+//
+// file: BitSlicedColumn.h
+// desc: ACS Project 4 Bit-Sliced Column Header
+// auth: Andrew Prata
+//
+// This program implements an in-memory bit-packed
+// layout for the encoded column (vertical bit slices,
+// as in BitWeaving/V). Every block of 256 rows stores
+// bit j of all of its codes in one 256-bit slice, so
+// one AVX2 instruction evaluates a predicate on one
+// bit of 256 codes at once, at any code width from 1
+// to 32 and without unpacking a single code.
+//
+
+#pragma once
+
+#include <cstdint>     // std::uint64_t/std::uint32_t
+#include <vector>      // std::vector
+#include <algorithm>   // std::min
+#include <immintrin.h> // AVX2 intrinsics
+
+// Encoded column held as bit slices: block b, slice j = bit (width - 1 - j) of the block's 256 codes
+//  (most significant bit first). Row r of a block is bit r % 64 of the slice's word r / 64, so a
+//  predicate result computed on the slices is already the selection bitmap of the block.
+class BitSlicedColumn {
+private:
+    static constexpr size_t blockRows = 256;
+    static constexpr size_t blockWords = blockRows / 64;
+    std::vector<std::uint64_t> slices; // blockWords words per slice, width slices per block
+    size_t rows = 0;
+    unsigned width = 0;
+
+    size_t blockCount() const {
+        return (rows + blockRows - 1) / blockRows;
+    }
+
+    const std::uint64_t* sliceAt(size_t block, unsigned j) const {
+        return slices.data() + (block * width + j) * blockWords;
+    }
+
+    // Helper to size a bitmap for every block, then trim it to the rows (clearing padding rows)
+    void beginBitmap(std::vector<std::uint64_t>& bitmap) const {
+        bitmap.assign(blockCount() * blockWords, 0);
+    }
+
+    void endBitmap(std::vector<std::uint64_t>& bitmap) const {
+        bitmap.resize((rows + 63) / 64);
+        if (rows % 64 != 0) {
+            bitmap.back() &= (std::uint64_t(1) << (rows % 64)) - 1;
+        }
+    }
+
+    // Helper to broadcast bit (width - 1 - j) of value into all-ones / all-zeros slice masks
+    void constantSlices(std::uint32_t value, __m256i* out) const {
+        for (unsigned j = 0; j < width; ++j) {
+            out[j] = _mm256_set1_epi64x(((value >> (width - 1 - j)) & 1) ? -1 : 0);
+        }
+    }
+
+public:
+    // Function to build the slices from plain codes (each must fit in bitWidth bits, 1 to 32)
+    void build(const std::vector<int>& codes, unsigned bitWidth) {
+        rows = codes.size();
+        width = bitWidth;
+        slices.assign(blockCount() * width * blockWords, 0);
+        alignas(32) int padded[blockRows];
+        for (size_t block = 0; block < blockCount(); ++block) {
+            size_t first = block * blockRows;
+            size_t count = std::min(blockRows, rows - first);
+            const int* source = codes.data() + first;
+            if (count < blockRows) { // Zero padding; padding rows are cleared from every bitmap
+                std::fill(padded, padded + blockRows, 0);
+                std::copy(source, source + count, padded);
+                source = padded;
+            }
+            std::uint64_t* out = slices.data() + block * width * blockWords;
+            // Eight codes at a time: shift bit b into the sign position and gather the eight signs
+            for (size_t group = 0; group < blockRows / 8; ++group) {
+                __m256i codes8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + group * 8));
+                for (unsigned j = 0; j < width; ++j) {
+                    __m256i shifted = _mm256_sll_epi32(codes8, _mm_cvtsi32_si128(31 - (width - 1 - j)));
+                    std::uint64_t signs = _mm256_movemask_ps(_mm256_castsi256_ps(shifted));
+                    out[j * blockWords + group / 8] |= signs << ((group % 8) * 8);
+                }
+            }
+        }
+    }
+
+    size_t size() const {
+        return rows;
+    }
+
+    unsigned bitWidth() const {
+        return width;
+    }
+
+    // Bytes of storage (rows * width bits, rounded up to whole blocks)
+    size_t memoryBytes() const {
+        return slices.size() * sizeof(std::uint64_t);
+    }
+
+    // Function to select the rows whose code equals code (bit i of bitmap = row i)
+    void equalTo(std::uint32_t code, std::vector<std::uint64_t>& bitmap) const {
+        beginBitmap(bitmap);
+        if (width < 32 && code >> width != 0) {
+            endBitmap(bitmap);
+            return; // Wider than any stored code
+        }
+        __m256i constant[32];
+        constantSlices(code, constant);
+        for (size_t block = 0; block < blockCount(); ++block) {
+            __m256i match = _mm256_set1_epi64x(-1);
+            for (unsigned j = 0; j < width; ++j) {
+                __m256i slice = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sliceAt(block, j)));
+                match = _mm256_andnot_si256(_mm256_xor_si256(slice, constant[j]), match); // Bit agrees
+                if ((j & 3) == 3 && _mm256_testz_si256(match, match)) {
+                    break; // No row of the block can match any more
+                }
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(bitmap.data() + block * blockWords), match);
+        }
+        endBitmap(bitmap);
+    }
+
+    // Function to select the rows whose code is in [lo, hi) (bit i of bitmap = row i)
+    //  Both bounds are compared bit-serially, most significant bit first: a code is below a bound
+    //  at the first bit where they differ if that bit of the code is 0.
+    void inRange(std::uint32_t lo, std::uint32_t hi, std::vector<std::uint64_t>& bitmap) const {
+        beginBitmap(bitmap);
+        std::uint64_t limit = std::uint64_t(1) << width; // One past the largest storable code
+        if (lo >= hi || lo >= limit) {
+            endBitmap(bitmap);
+            return;
+        }
+        bool belowHiAlways = hi >= limit; // Every stored code is below hi
+        __m256i hiSlices[32];
+        __m256i loSlices[32];
+        constantSlices(belowHiAlways ? 0 : hi, hiSlices);
+        constantSlices(lo, loSlices);
+        __m256i ones = _mm256_set1_epi64x(-1);
+        for (size_t block = 0; block < blockCount(); ++block) {
+            __m256i belowHi = belowHiAlways ? ones : _mm256_setzero_si256();
+            __m256i belowLo = _mm256_setzero_si256();
+            __m256i equalHi = belowHiAlways ? _mm256_setzero_si256() : ones; // Rows still tied with hi
+            __m256i equalLo = ones;
+            for (unsigned j = 0; j < width; ++j) {
+                __m256i slice = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sliceAt(block, j)));
+                // Tied rows with a 0 where the bound has a 1 fall below it
+                belowHi = _mm256_or_si256(belowHi, _mm256_andnot_si256(slice, _mm256_and_si256(equalHi, hiSlices[j])));
+                belowLo = _mm256_or_si256(belowLo, _mm256_andnot_si256(slice, _mm256_and_si256(equalLo, loSlices[j])));
+                equalHi = _mm256_andnot_si256(_mm256_xor_si256(slice, hiSlices[j]), equalHi);
+                equalLo = _mm256_andnot_si256(_mm256_xor_si256(slice, loSlices[j]), equalLo);
+                if ((j & 3) == 3) {
+                    __m256i tied = _mm256_or_si256(equalHi, equalLo);
+                    if (_mm256_testz_si256(tied, tied)) {
+                        break; // Every row is decided against both bounds
+                    }
+                }
+            }
+            __m256i inside = _mm256_andnot_si256(belowLo, belowHi);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(bitmap.data() + block * blockWords), inside);
+        }
+        endBitmap(bitmap);
+    }
+};
+
+// Function to count the rows selected by a bitmap
+inline size_t bitmapCount(const std::vector<std::uint64_t>& bitmap) {
+    size_t count = 0;
+    for (std::uint64_t word : bitmap) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+// Function to turn a selection bitmap into row locations (in row order)
+inline void bitmapToLocations(const std::vector<std::uint64_t>& bitmap, std::vector<int>& target_locations) {
+    for (size_t w = 0; w < bitmap.size(); ++w) {
+        std::uint64_t word = bitmap[w];
+        while (word != 0) {
+            target_locations.push_back(static_cast<int>(w * 64 + __builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+}
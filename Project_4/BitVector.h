@@ -0,0 +1,202 @@
+//
+// file: BitVector.h
+// desc: ACS Project 4 Bit Vector Header
+// auth: Andrew Prata
+//
+// This program implements the bit-level building
+// blocks of the compact dictionary structures: a bit
+// vector with rank/select support and an array of
+// fixed-width (bit-packed) integers.
+//
+
+#pragma once
+
+#include <cstdint>   // std::uint64_t
+#include <vector>    // std::vector
+#include <algorithm> // std::min
+
+// Append-only bit vector; call buildRank() once before rank/select queries
+class BitVector {
+private:
+    static constexpr size_t blockBits = 512;      // Rank directory granularity (8 words)
+    std::vector<std::uint64_t> words;
+    std::vector<std::uint64_t> blockRanks;        // 1 bits before each block
+    std::vector<std::uint32_t> selectSamples[2];  // Word holding every 64th 0 bit / 1 bit
+    size_t bitCount = 0;
+
+public:
+    void push(bool bit) {
+        if (bitCount % 64 == 0) {
+            words.push_back(0);
+        }
+        if (bit) {
+            words.back() |= std::uint64_t(1) << (bitCount % 64);
+        }
+        ++bitCount;
+    }
+
+    bool get(size_t i) const {
+        return (words[i / 64] >> (i % 64)) & 1;
+    }
+
+    size_t size() const {
+        return bitCount;
+    }
+
+    // Function to build the rank and select directories (after the last push)
+    void buildRank() {
+        blockRanks.assign(words.size() / 8 + 2, 0);
+        selectSamples[0].clear();
+        selectSamples[1].clear();
+        std::uint64_t ones = 0;
+        for (size_t w = 0; w < words.size(); ++w) {
+            if (w % 8 == 0) {
+                blockRanks[w / 8] = ones;
+            }
+            size_t count = __builtin_popcountll(words[w]);
+            size_t zeros = std::min<size_t>(64, bitCount - w * 64) - count;
+            size_t zerosBefore = w * 64 - ones;
+            // Record the word of every 64th bit of each kind that falls in this word
+            while (selectSamples[1].size() * 64 < ones + count) {
+                selectSamples[1].push_back(w);
+            }
+            while (selectSamples[0].size() * 64 < zerosBefore + zeros) {
+                selectSamples[0].push_back(w);
+            }
+            ones += count;
+        }
+        blockRanks[(words.size() + 7) / 8] = ones;
+    }
+
+    // Number of 1 bits in [0, i)
+    size_t rank1(size_t i) const {
+        size_t block = i / blockBits;
+        size_t rank = blockRanks[block];
+        for (size_t w = block * 8; w < i / 64; ++w) {
+            rank += __builtin_popcountll(words[w]);
+        }
+        if (i % 64 != 0) {
+            rank += __builtin_popcountll(words[i / 64] & ((std::uint64_t(1) << (i % 64)) - 1));
+        }
+        return rank;
+    }
+
+    // Number of 0 bits in [0, i)
+    size_t rank0(size_t i) const {
+        return i - rank1(i);
+    }
+
+    // Position of the first 1 bit at or after i (size() if none)
+    size_t nextOne(size_t i) const {
+        if (i >= bitCount) {
+            return bitCount;
+        }
+        size_t w = i / 64;
+        std::uint64_t word = words[w] & (~std::uint64_t(0) << (i % 64));
+        while (word == 0) {
+            if (++w == words.size()) {
+                return bitCount;
+            }
+            word = words[w];
+        }
+        return w * 64 + __builtin_ctzll(word); // Padding bits are never set
+    }
+
+    // Position of the k-th 1 bit (k counts from 0)
+    size_t select1(size_t k) const {
+        return select(k, true);
+    }
+
+    // Position of the k-th 0 bit (k counts from 0)
+    size_t select0(size_t k) const {
+        return select(k, false);
+    }
+
+    // Bytes of storage (bits plus rank and select directories)
+    size_t memoryBytes() const {
+        return (words.size() + blockRanks.size()) * sizeof(std::uint64_t) +
+               (selectSamples[0].size() + selectSamples[1].size()) * sizeof(std::uint32_t);
+    }
+
+private:
+    size_t select(size_t k, bool one) const {
+        // Jump to the word holding the nearest sampled bit at or before k, then scan forward
+        const std::vector<std::uint32_t>& samples = selectSamples[one];
+        if (k / 64 >= samples.size()) {
+            return bitCount; // Fewer than k + 1 such bits
+        }
+        size_t w = samples[k / 64];
+        size_t before = one ? rank1(w * 64) : rank0(w * 64);
+        size_t remaining = k - before;
+        for (; w < words.size(); ++w) {
+            std::uint64_t word = one ? words[w] : ~words[w];
+            if (!one && w + 1 == words.size() && bitCount % 64 != 0) {
+                word &= (std::uint64_t(1) << (bitCount % 64)) - 1; // Padding is not a 0 bit
+            }
+            size_t count = __builtin_popcountll(word);
+            if (remaining < count) {
+                for (size_t r = 0; r < remaining; ++r) {
+                    word &= word - 1; // Drop the lowest set bit
+                }
+                return w * 64 + __builtin_ctzll(word);
+            }
+            remaining -= count;
+        }
+        return bitCount;
+    }
+};
+
+// Array of unsigned integers stored at a fixed bit width
+class PackedArray {
+private:
+    std::vector<std::uint64_t> words;
+    unsigned width = 0;
+    size_t count = 0;
+
+public:
+    PackedArray() = default;
+
+    PackedArray(size_t n, unsigned bitWidth) : words((n * bitWidth + 63) / 64 + 1, 0), width(bitWidth), count(n) {}
+
+    // Function to get the minimum width that holds values up to maxValue
+    static unsigned bitsFor(std::uint64_t maxValue) {
+        unsigned bits = 1;
+        while (bits < 64 && (maxValue >> bits) != 0) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    void set(size_t i, std::uint64_t value) {
+        size_t bit = i * width;
+        std::uint64_t mask = (width == 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        value &= mask;
+        words[bit / 64] = (words[bit / 64] & ~(mask << (bit % 64))) | (value << (bit % 64));
+        if (bit % 64 + width > 64) { // Straddles two words
+            size_t spill = 64 - bit % 64;
+            words[bit / 64 + 1] = (words[bit / 64 + 1] & ~(mask >> spill)) | (value >> spill);
+        }
+    }
+
+    std::uint64_t get(size_t i) const {
+        size_t bit = i * width;
+        std::uint64_t mask = (width == 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        std::uint64_t value = words[bit / 64] >> (bit % 64);
+        if (bit % 64 + width > 64) {
+            value |= words[bit / 64 + 1] << (64 - bit % 64);
+        }
+        return value & mask;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    unsigned bitWidth() const {
+        return width;
+    }
+
+    size_t memoryBytes() const {
+        return words.size() * sizeof(std::uint64_t);
+    }
+};
@@ -0,0 +1,214 @@
+//
+// file: EncodedColumn.h
+// desc: ACS Project 4 Encoded Column File Header
+// auth: Andrew Prata
+//
+// This program implements the binary encoded column
+// file: a 64-byte header (row count, bit width and a
+// checksum of the dictionary that produced the codes)
+// followed by every code bit-packed at the smallest
+// width that holds the dictionary's codes. The file is
+// memory-mapped on load, so reading it needs no parsing.
+//
+
+#pragma once
+
+#include "MappedFile.h" // Read-only file mapping
+#include <algorithm>    // std::min
+#include <cstdint>      // std::uint64_t/std::uint32_t
+#include <cstdio>       // std::remove
+#include <cstring>      // std::memcpy/std::memcmp
+#include <fstream>      // std::ofstream
+#include <iostream>     // std::cerr
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// File layout: header, then ceil(rowCount * bitWidth / 64) + 1 little-endian 64-bit words.
+//  Code i occupies bits [i * bitWidth, (i + 1) * bitWidth) of the word stream; the extra
+//  word lets a reader fetch any code with one unaligned 8-byte load.
+struct EncodedColumnHeader {
+    char magic[8];                    // "ACSCOL1\0"
+    std::uint64_t rowCount;
+    std::uint32_t bitWidth;           // 1 to 32
+    std::uint32_t reserved;
+    std::uint64_t dictionaryChecksum; // EncoderDictionary::checksum() of the writing dictionary
+    std::uint64_t padding[4];         // Codes start 64 bytes in (cache-line aligned in the mapping)
+};
+static_assert(sizeof(EncodedColumnHeader) == 64, "Encoded column header must be 64 bytes");
+
+constexpr char encodedColumnMagic[8] = {'A', 'C', 'S', 'C', 'O', 'L', '1', '\0'};
+
+// Function to get the code width for a dictionary of dictSize keys: ceil(log2(dictSize)), at least 1
+//  Every value of that width may be a real code, so there is no room for a "missing key" marker:
+//  the writer refuses codes outside [0, 2^width) instead.
+inline unsigned encodedBitWidth(size_t dictSize) {
+    unsigned bits = 1;
+    while (bits < 32 && (std::uint64_t(1) << bits) < dictSize) {
+        ++bits;
+    }
+    return bits;
+}
+
+// Streaming writer: the header first, then codes appended in row order
+//  A code that does not fit the width (such as -1 for a key missing from the dictionary) fails the
+//  write: nothing more is appended and close() deletes the partial file.
+class EncodedColumnWriter {
+private:
+    std::string path;
+    std::ofstream file_out;
+    std::vector<std::uint64_t> buffer; // Finished words not yet written
+    std::uint64_t pending = 0;         // Partially filled word
+    unsigned pendingBits = 0;
+    unsigned width;
+    std::uint64_t mask;
+    std::uint64_t expectedRows;
+    std::uint64_t writtenRows = 0;
+    bool failed = false;
+
+    void flushBuffer() {
+        file_out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(std::uint64_t));
+        buffer.clear();
+    }
+
+public:
+    EncodedColumnWriter(const std::string& filepath, std::uint64_t rowCount, unsigned bitWidth,
+                        std::uint64_t dictionaryChecksum)
+        : path(filepath), file_out(filepath, std::ios::binary), width(bitWidth), mask((std::uint64_t(1) << bitWidth) - 1),
+          expectedRows(rowCount) {
+        if (!file_out.is_open()) {
+            std::cerr << "Error: Could not open the file " << filepath << '\n';
+            failed = true;
+        }
+        EncodedColumnHeader header = {};
+        std::memcpy(header.magic, encodedColumnMagic, sizeof(header.magic));
+        header.rowCount = rowCount;
+        header.bitWidth = bitWidth;
+        header.dictionaryChecksum = dictionaryChecksum;
+        file_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        buffer.reserve(8192);
+    }
+
+    // Function to append codes (each must be in [0, 2^bitWidth)); false if one does not fit
+    bool append(const std::vector<int>& codes) {
+        if (failed) {
+            return false;
+        }
+        for (int code : codes) {
+            if (code < 0 || static_cast<std::uint64_t>(code) > mask) {
+                std::cerr << "Error: Code " << code << " does not fit a " << width << "-bit encoded column"
+                          << " (keys missing from the dictionary cannot be encoded)" << '\n';
+                failed = true;
+                return false;
+            }
+            std::uint64_t value = static_cast<std::uint64_t>(code);
+            pending |= value << pendingBits;
+            pendingBits += width;
+            if (pendingBits >= 64) {
+                buffer.push_back(pending);
+                pendingBits -= 64;
+                pending = (pendingBits == 0) ? 0 : value >> (width - pendingBits); // Bits that spilled over
+                if (buffer.size() == buffer.capacity()) {
+                    flushBuffer();
+                }
+            }
+        }
+        writtenRows += codes.size();
+        return true;
+    }
+
+    // Function to write the last partial word and the padding word, then close the file
+    //  Returns false (and removes the file) if any append failed or the row count is short.
+    bool close() {
+        if (!failed && writtenRows != expectedRows) {
+            std::cerr << "Error: Encoded column header promised " << expectedRows << " rows, got "
+                      << writtenRows << '\n';
+            failed = true;
+        }
+        if (!failed) {
+            if (pendingBits > 0) {
+                buffer.push_back(pending);
+            }
+            buffer.push_back(0);
+            flushBuffer();
+            file_out.flush();
+        }
+        file_out.close();
+        if (failed) {
+            std::remove(path.c_str());
+        }
+        return !failed;
+    }
+};
+
+// Read-only encoded column, mapped straight from its file (the codes are used in place)
+class EncodedColumn {
+private:
+    MappedFile file;
+    const EncodedColumnHeader* header = nullptr;
+    const unsigned char* codes = nullptr; // Start of the packed words
+
+public:
+    explicit EncodedColumn(const std::string& filepath) : file(filepath) {
+        if (!file.isOpen()) {
+            return;
+        }
+        std::string_view bytes = file.bytes();
+        const EncodedColumnHeader* candidate = reinterpret_cast<const EncodedColumnHeader*>(bytes.data());
+        // The payload holds whole words plus one padding word; compare by dividing, since
+        //  rowCount * bitWidth can wrap for a corrupt header
+        std::uint64_t payloadWords = (bytes.size() - std::min(bytes.size(), sizeof(EncodedColumnHeader))) /
+                                     sizeof(std::uint64_t);
+        if (bytes.size() < sizeof(EncodedColumnHeader) ||
+            std::memcmp(candidate->magic, encodedColumnMagic, sizeof(encodedColumnMagic)) != 0 ||
+            candidate->bitWidth < 1 || candidate->bitWidth > 32 || payloadWords < 1 ||
+            candidate->rowCount > ((payloadWords - 1) * 64) / candidate->bitWidth) {
+            std::cerr << "Error: " << filepath << " is not a valid encoded column file" << '\n';
+            return;
+        }
+        header = candidate;
+        codes = reinterpret_cast<const unsigned char*>(bytes.data()) + sizeof(EncodedColumnHeader);
+    }
+
+    bool isValid() const {
+        return header != nullptr;
+    }
+
+    size_t size() const {
+        return isValid() ? header->rowCount : 0;
+    }
+
+    unsigned bitWidth() const {
+        return isValid() ? header->bitWidth : 0;
+    }
+
+    std::uint64_t dictionaryChecksum() const {
+        return isValid() ? header->dictionaryChecksum : 0;
+    }
+
+    // Packed words (64-byte aligned within the page-aligned mapping)
+    const std::uint64_t* packedWords() const {
+        return reinterpret_cast<const std::uint64_t*>(codes);
+    }
+
+    // Bytes of the file on disk
+    size_t fileBytes() const {
+        return file.bytes().size();
+    }
+
+    // Function to read code i (one unaligned 8-byte load; width <= 32 keeps it inside the load)
+    std::uint32_t get(size_t i) const {
+        std::uint64_t bit = std::uint64_t(i) * header->bitWidth;
+        std::uint64_t word;
+        std::memcpy(&word, codes + bit / 8, sizeof(word));
+        return static_cast<std::uint32_t>((word >> (bit % 8)) & ((std::uint64_t(1) << header->bitWidth) - 1));
+    }
+
+    // Function to unpack every code into a plain integer vector
+    void unpack(std::vector<int>& out) const {
+        size_t n = size();
+        out.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<int>(get(i));
+        }
+    }
+};
@@ -7,128 +7,496 @@
 // and its helper functions.
 //
 
-#include "FStreamHelper.h" // File operations
-#include <map>             // std::map
-#include <string>          // std::string 
-#include <mutex>           // std::mutex/std::lock_guard
-#include <vector>          // std::vector
-#include <cmath>           // floor()
-#include <thread>          // std::thread
-#include <emmintrin.h>     // AVX2 intrinsics
+#include "FStreamHelper.h"   // File operations
+#include "SwissTable.h"      // Open-addressing hash table
+#include "SuccinctTrie.h"    // Static compressed trie
+#include "StringArena.h"     // Contiguous string storage
+#include "MappedFile.h"      // Memory-mapped input split on line boundaries
+#include "EncodedColumn.h"   // Binary bit-packed encoded file
+#include "BitSlicedColumn.h" // Bit-sliced column and packed predicate scans
+#include <string>            // std::string 
+#include <string_view>       // std::string_view
+#include <mutex>             // std::mutex/std::lock_guard
+#include <atomic>            // std::atomic (global code counter)
+#include <memory>            // std::unique_ptr
+#include <vector>            // std::vector
+#include <algorithm>         // std::sort/std::lower_bound
+#include <cmath>             // floor()
+#include <thread>            // std::thread
+#include <emmintrin.h>       // AVX2 intrinsics
+#include <immintrin.h>       // AVX2 (256-bit) intrinsics
+
+// Lock traffic on one dictionary shard
+struct ShardContention {
+    unsigned long long acquisitions = 0; // Times the shard lock was taken
+    unsigned long long contended = 0;    // Times it was already held by another thread
+};
+
+// Private dictionary for one chunk of the input (phase 1 of the two-phase build)
+//  Local codes are handed out in first-occurrence order within the chunk.
+struct ChunkDictionary {
+    SwissTable table;
+    std::vector<int> rowCodes;      // Local code of every row in the chunk
+    std::vector<unsigned> keySlots; // Table slot of each local code (filled once the chunk is done)
+
+    int addKey(std::string_view key) {
+        auto inserted = table.insert(key, hashKey(key), static_cast<int>(table.size()));
+        return *inserted.first;
+    }
+
+    // Function to record where each local code lives (the table no longer changes after this)
+    void finish() {
+        keySlots.assign(table.size(), 0);
+        for (size_t slot = 0; slot < table.slotCount(); ++slot) {
+            if (table.occupied(slot)) {
+                keySlots[table.valueAt(slot)] = slot;
+            }
+        }
+    }
+};
 
 // Class for the encoding translation dictionary
+//  Keys are spread over shards by hash, each a Swiss table with its own lock, so threads adding
+//  different keys rarely wait on each other. Codes come from one atomic counter that is only
+//  advanced on a real insert, so they stay unique and dense across shards. Prefix queries use a
+//  sorted index over every shard, built on the first prefix query after the dictionary changed.
 class EncoderDictionary {
 private:
-    std::map<std::string, int> dictionary;
-    int nextValue;
-    std::mutex dictionaryMutex; // Mutex for contruction synchronization
+    static constexpr size_t shardBits = 6;
+    static constexpr size_t shardCount = size_t(1) << shardBits;
+
+    struct Shard {
+        SwissTable table;
+        std::mutex mutex;
+        ShardContention contention; // Updated while holding mutex
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::atomic<int> nextValue;
+    std::mutex indexMutex;                       // Guards the sorted index
+    std::vector<unsigned long long> sortedSlots; // (shard << 32 | slot) in key order (prefix index)
+    std::atomic<bool> sortedValid{false};
+    bool codesInKeyOrder = false;                // Code i is the i-th smallest key (valid with the index)
+
+    // Top hash bits pick the shard; the table itself uses the low bits
+    Shard& shardFor(std::uint64_t hash) {
+        return shards[hash >> (64 - shardBits)];
+    }
+
+    // Helper to take a shard lock, counting the times it had to wait
+    static std::unique_lock<std::mutex> lockShard(Shard& shard) {
+        std::unique_lock<std::mutex> lock(shard.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            lock.lock();
+            ++shard.contention.contended;
+        }
+        ++shard.contention.acquisitions;
+        return lock;
+    }
+
+    // Helper to drop the sorted index after an insert
+    //  Loads before it stores, so a build writes the shared flag once instead of every insert
+    //  pulling its cache line across the threads (relaxed: the index is only read and rebuilt
+    //  under indexMutex with no inserts running)
+    void invalidateSortedIndex() {
+        if (sortedValid.load(std::memory_order_relaxed)) {
+            sortedValid.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::string_view keyAt(unsigned long long entry) const {
+        return shards[entry >> 32].table.keyAt(entry & 0xFFFFFFFFu);
+    }
+
+    int valueAt(unsigned long long entry) const {
+        return shards[entry >> 32].table.valueAt(entry & 0xFFFFFFFFu);
+    }
+
+    // Helper to (re)build the sorted prefix index (caller holds indexMutex; no concurrent inserts)
+    void buildSortedIndex() {
+        if (sortedValid) {
+            return;
+        }
+        sortedSlots.clear();
+        sortedSlots.reserve(size());
+        for (size_t s = 0; s < shardCount; ++s) {
+            const SwissTable& table = shards[s].table;
+            for (size_t slot = 0; slot < table.slotCount(); ++slot) {
+                if (table.occupied(slot)) {
+                    sortedSlots.push_back((static_cast<unsigned long long>(s) << 32) | slot);
+                }
+            }
+        }
+        std::sort(sortedSlots.begin(), sortedSlots.end(), [this](unsigned long long a, unsigned long long b) {
+            return keyAt(a) < keyAt(b);
+        });
+        codesInKeyOrder = true;
+        for (size_t i = 0; i < sortedSlots.size() && codesInKeyOrder; ++i) {
+            codesInKeyOrder = valueAt(sortedSlots[i]) == static_cast<int>(i);
+        }
+        sortedValid = true;
+    }
+
+    // Helper to find the first key >= target in the sorted index (caller holds indexMutex)
+    size_t lowerBoundIndex(std::string_view target) {
+        auto it = std::lower_bound(sortedSlots.begin(), sortedSlots.end(), target,
+            [this](unsigned long long entry, std::string_view key) { return keyAt(entry) < key; });
+        return it - sortedSlots.begin();
+    }
+
 public:
     // Constructor
-    EncoderDictionary() : nextValue(0) {}
-
-    // Function to add a key
-    int addKey(const std::string& key) {
-        std::lock_guard<std::mutex> lock(dictionaryMutex); // Lock the mutex to prevent thread collision
-        //std::cout << "Structure locked" << std::endl;
-        // Iterator to the KVP
-        auto it = dictionary.find(key);
-        // Key already exists, return its value
-        if (it != dictionary.end()) {
-            //std::cout << "Exiting scope, releasing lock" << std::endl;
-            return it->second;
-        // Key doesn't exist, add it with the next integer encoding
-        } else {
-            dictionary[key] = nextValue;
-            //std::cout << "Exiting scope, releasing lock" << std::endl;
-            return nextValue++;
+    EncoderDictionary() : shards(new Shard[shardCount]), nextValue(0) {}
+
+    // Function to add a key (the hash is computed once and reused for the lookup and the insert)
+    int addKey(std::string_view key) {
+        std::uint64_t hash = hashKey(key);
+        Shard& shard = shardFor(hash);
+        auto lock = lockShard(shard); // Only keys in the same shard contend
+        // Key already exists: return its value. Otherwise it takes the next integer encoding
+        auto inserted = shard.table.insert(key, hash, 0);
+        if (inserted.second) {
+            *inserted.first = nextValue.fetch_add(1);
+            invalidateSortedIndex();
+        }
+        return *inserted.first;
+    }
+
+    // Function to add a key with a known encoding (used when reading a dictionary file)
+    void setKey(std::string_view key, int value) {
+        std::uint64_t hash = hashKey(key);
+        Shard& shard = shardFor(hash);
+        auto lock = lockShard(shard);
+        *shard.table.insert(key, hash, value).first = value;
+        invalidateSortedIndex();
+        int next = nextValue.load();
+        while (next < value + 1 && !nextValue.compare_exchange_weak(next, value + 1)) {
         }
     }
 
     // Function to retrieve a key encoding value
-    int getEncoding(const std::string& key) {
-        std::lock_guard<std::mutex> lock(dictionaryMutex); // Lock the mutex (this may be multithreaded eventually)
-        auto it = dictionary.find(key);
-        if (it == dictionary.end()) {
+    int getEncoding(std::string_view key) {
+        return getEncoding(key, hashKey(key));
+    }
+
+    // Function to retrieve a key encoding value with a precomputed hash (see hashKey)
+    int getEncoding(std::string_view key, std::uint64_t hash) {
+        Shard& shard = shardFor(hash);
+        auto lock = lockShard(shard);
+        const int* value = shard.table.find(key, hash);
+        if (value == nullptr) {
             std::cout << "Key " << key << " does not exist in the dictionary." << "\n";
             return -1;
         }
-        return dictionary.find(key)->second;
+        return *value;
     }
 
     // Function to return a vector of encoding values for all keys that have a particular prefix
-    std::vector<int> getEncodingValuesWithPrefix(const std::string& prefix) {
-        std::lock_guard<std::mutex> lock(dictionaryMutex);
-
-        auto lower = dictionary.lower_bound(prefix);
-        auto upper = dictionary.upper_bound(prefix + char(255)); // char(255) is used to get the upper bound
+    std::vector<int> getEncodingValuesWithPrefix(std::string_view prefix) {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        buildSortedIndex();
 
+        // Keys with the prefix are contiguous in key order, starting at the first key >= prefix
         std::vector<int> encodingValues;
-        for (auto it = lower; it != upper; ++it) {
-            encodingValues.push_back(it->second);
-            //std::cout << it->first << std::endl;
+        for (size_t i = lowerBoundIndex(prefix); i < sortedSlots.size(); ++i) {
+            std::string_view key = keyAt(sortedSlots[i]);
+            if (key.compare(0, prefix.length(), prefix) != 0) {
+                break;
+            }
+            encodingValues.push_back(valueAt(sortedSlots[i]));
         }
 
         return encodingValues;
     }
 
-    // Function to provide access to the internal dictionary
-    std::map<std::string, int>& getDictionary() {
-        return dictionary;
+    // Function to renumber the codes in sorted key order; returns old code -> new code
+    //  Afterwards every prefix or key range maps to one contiguous code interval.
+    std::vector<int> assignSortedCodes() {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        buildSortedIndex();
+        std::vector<int> remap(nextValue.load(), -1);
+        for (size_t i = 0; i < sortedSlots.size(); ++i) {
+            unsigned long long entry = sortedSlots[i];
+            int& value = shards[entry >> 32].table.valueAt(entry & 0xFFFFFFFFu);
+            remap[value] = static_cast<int>(i);
+            value = static_cast<int>(i);
+        }
+        nextValue = static_cast<int>(sortedSlots.size());
+        codesInKeyOrder = true;
+        return remap;
+    }
+
+    // Function to check whether codes follow key order (assignSortedCodes, or a dictionary file written after it)
+    bool orderPreserving() {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        buildSortedIndex();
+        return codesInKeyOrder;
+    }
+
+    // Function to get the code interval [lo, hi) of the keys in [lowKey, highKey) (order-preserving codes only)
+    bool getCodeRange(std::string_view lowKey, std::string_view highKey, int& lo, int& hi) {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        buildSortedIndex();
+        if (!codesInKeyOrder) {
+            return false;
+        }
+        lo = static_cast<int>(lowerBoundIndex(lowKey));
+        hi = std::max(lo, static_cast<int>(lowerBoundIndex(highKey)));
+        return true;
+    }
+
+    // Function to get the code interval [lo, hi) of the keys starting with prefix (order-preserving codes only)
+    bool getCodeRangeWithPrefix(std::string_view prefix, int& lo, int& hi) {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        buildSortedIndex();
+        if (!codesInKeyOrder) {
+            return false;
+        }
+        lo = static_cast<int>(lowerBoundIndex(prefix));
+        // The interval ends at the first key that no longer starts with the prefix
+        auto end = std::partition_point(sortedSlots.begin() + lo, sortedSlots.end(), [&](unsigned long long entry) {
+            return keyAt(entry).compare(0, prefix.length(), prefix) == 0;
+        });
+        hi = static_cast<int>(end - sortedSlots.begin());
+        return true;
+    }
+
+    // Function to visit every (key, encoding) pair in key order (keys are std::string_view)
+    template <typename F>
+    void forEachSorted(F visit) {
+        std::lock_guard<std::mutex> lock(indexMutex);
+        buildSortedIndex();
+        for (unsigned long long entry : sortedSlots) {
+            visit(keyAt(entry), valueAt(entry));
+        }
     }
 
     // Wrapper function for size() of internal dict
     size_t size() const {
-        return dictionary.size();
+        size_t total = 0;
+        for (size_t s = 0; s < shardCount; ++s) {
+            total += shards[s].table.size();
+        }
+        return total;
     }
 
-    // Function to access the dictionary mutex (not needed just yet.)
-    std::mutex& getMutex() {
-        return dictionaryMutex;
+    // Function to merge finished chunk dictionaries (in input order) into this empty dictionary
+    //  Global codes follow first occurrence in the whole input, exactly as sequential addKey calls
+    //  would assign them, so the result does not depend on the number of chunks or threads.
+    //  Each chunk's rowCodes are rewritten from local to global codes.
+    void mergeChunks(std::vector<ChunkDictionary>& chunks, size_t num_threads) {
+        auto parallelFor = [num_threads](size_t count, auto body) {
+            std::vector<std::thread> threads;
+            size_t workers = std::max<size_t>(1, std::min(num_threads, count));
+            for (size_t w = 0; w < workers; ++w) {
+                threads.emplace_back([&, w] {
+                    for (size_t i = w; i < count; i += workers) {
+                        body(i);
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+
+        // Local keys are numbered chunk by chunk: flat id = flatBase[chunk] + local code
+        std::vector<size_t> flatBase(chunks.size() + 1, 0);
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            flatBase[c + 1] = flatBase[c] + chunks[c].table.size();
+        }
+        std::vector<unsigned> firstOwner(flatBase.back()); // Flat id of each key's first occurrence
+
+        // Bucket each chunk's local codes by shard (counting sort, local code order kept per shard)
+        std::vector<std::vector<unsigned>> byShard(chunks.size());
+        std::vector<std::vector<unsigned>> shardStart(chunks.size());
+        parallelFor(chunks.size(), [&](size_t c) {
+            const ChunkDictionary& chunk = chunks[c];
+            std::vector<unsigned>& start = shardStart[c];
+            start.assign(shardCount + 1, 0);
+            for (unsigned slot : chunk.keySlots) {
+                ++start[(chunk.table.hashAt(slot) >> (64 - shardBits)) + 1];
+            }
+            for (size_t s = 0; s < shardCount; ++s) {
+                start[s + 1] += start[s];
+            }
+            std::vector<unsigned> next(start.begin(), start.end() - 1);
+            byShard[c].resize(chunk.keySlots.size());
+            for (size_t code = 0; code < chunk.keySlots.size(); ++code) {
+                byShard[c][next[chunk.table.hashAt(chunk.keySlots[code]) >> (64 - shardBits)]++] = code;
+            }
+        });
+
+        // Shards are independent: each worker inserts the keys of its shards, walking the chunks
+        // in input order, so the first chunk (and local code) to reach a key owns it
+        parallelFor(shardCount, [&](size_t s) {
+            SwissTable& table = shards[s].table;
+            for (size_t c = 0; c < chunks.size(); ++c) {
+                const ChunkDictionary& chunk = chunks[c];
+                for (unsigned i = shardStart[c][s]; i < shardStart[c][s + 1]; ++i) {
+                    unsigned code = byShard[c][i];
+                    unsigned slot = chunk.keySlots[code];
+                    unsigned flat = flatBase[c] + code;
+                    firstOwner[flat] = *table.insert(chunk.table.keyAt(slot), chunk.table.hashAt(slot), flat).first;
+                }
+            }
+        });
+
+        // Global code of a key = number of keys first seen before it (prefix sum over chunks)
+        std::vector<size_t> newKeys(chunks.size() + 1, 0);
+        parallelFor(chunks.size(), [&](size_t c) {
+            for (size_t flat = flatBase[c]; flat < flatBase[c + 1]; ++flat) {
+                newKeys[c + 1] += (firstOwner[flat] == flat);
+            }
+        });
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            newKeys[c + 1] += newKeys[c];
+        }
+        std::vector<int> globalCode(flatBase.back());
+        parallelFor(chunks.size(), [&](size_t c) {
+            int next = static_cast<int>(newKeys[c]);
+            for (size_t flat = flatBase[c]; flat < flatBase[c + 1]; ++flat) {
+                if (firstOwner[flat] == flat) {
+                    globalCode[flat] = next++;
+                }
+            }
+        });
+
+        // The tables still hold owner flat ids; replace them with the global codes
+        parallelFor(shardCount, [&](size_t s) {
+            SwissTable& table = shards[s].table;
+            for (size_t slot = 0; slot < table.slotCount(); ++slot) {
+                if (table.occupied(slot)) {
+                    table.valueAt(slot) = globalCode[table.valueAt(slot)];
+                }
+            }
+        });
+
+        // Remap every chunk's rows from local to global codes
+        parallelFor(chunks.size(), [&](size_t c) {
+            std::vector<int> localToGlobal(chunks[c].keySlots.size());
+            for (size_t code = 0; code < localToGlobal.size(); ++code) {
+                localToGlobal[code] = globalCode[firstOwner[flatBase[c] + code]];
+            }
+            for (int& row : chunks[c].rowCodes) {
+                row = localToGlobal[row];
+            }
+        });
+
+        nextValue = static_cast<int>(newKeys.back());
+        sortedValid = false;
     }
-};
 
-// Asynchronously process a portion of the input and form the correlated portion of dictionary d
-void asyncProcessor(const std::string& filepath_in, size_t start, size_t end, EncoderDictionary& d) {
-    // Open & Verify
-    std::ifstream file_in_async = openFileForReading(filepath_in);
+    // Function to fingerprint the (key, code) pairs, independent of insertion order (no concurrent inserts)
+    //  Stored in encoded files so a column is never decoded with a different dictionary.
+    std::uint64_t checksum() const {
+        std::uint64_t sum = size();
+        for (size_t s = 0; s < shardCount; ++s) {
+            const SwissTable& table = shards[s].table;
+            for (size_t slot = 0; slot < table.slotCount(); ++slot) {
+                if (table.occupied(slot)) {
+                    std::uint64_t x = table.hashAt(slot) + static_cast<std::uint64_t>(table.valueAt(slot)) * 0x9E3779B97F4A7C15ull;
+                    x = (x ^ (x >> 31)) * 0xBF58476D1CE4E5B9ull;
+                    sum += x ^ (x >> 29);
+                }
+            }
+        }
+        return sum;
+    }
 
-    // Seek to the beginning of the desired line
-    for (size_t i = 0; i < start; ++i) {
-        file_in_async.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    // Bytes of storage over every shard (tables and key arenas)
+    size_t memoryBytes() const {
+        size_t total = 0;
+        for (size_t s = 0; s < shardCount; ++s) {
+            total += shards[s].table.memoryBytes();
+        }
+        return total;
     }
 
-    // Process lines from start to end of thread region
-    std::string line;
-    size_t current_position = start;
-    while (current_position < end && std::getline(file_in_async, line)) {
-        d.addKey(line); // Mutex critical region. Must be multithread protected (see class)
-        current_position++;
+    // Function to estimate the footprint with a std::string key in every slot (see SwissTable::stringSlotBytes)
+    size_t stringSlotBytes() const {
+        size_t total = 0;
+        for (size_t s = 0; s < shardCount; ++s) {
+            total += shards[s].table.stringSlotBytes();
+        }
+        return total;
     }
+
+    // Function to snapshot the per-shard lock counters
+    std::vector<ShardContention> shardContention() {
+        std::vector<ShardContention> counters(shardCount);
+        for (size_t s = 0; s < shardCount; ++s) {
+            std::lock_guard<std::mutex> lock(shards[s].mutex);
+            counters[s] = shards[s].contention;
+        }
+        return counters;
+    }
+};
+
+// Function to build a static succinct trie from a finished dictionary (codes must be dense)
+SuccinctTrie buildSuccinctTrie(EncoderDictionary& d) {
+    std::vector<std::string_view> keys;
+    std::vector<int> codes;
+    keys.reserve(d.size());
+    codes.reserve(d.size());
+    d.forEachSorted([&](std::string_view key, int value) {
+        keys.push_back(key); // Views into the dictionary, which is not modified meanwhile
+        codes.push_back(value);
+    });
+    SuccinctTrie trie;
+    trie.build(keys, codes);
+    return trie;
 }
 
-// Form the dictionary itself, with keys as the original data and values as the encodings
-void createDictionary(const std::string& filepath_in, const std::string& dictpath_out, EncoderDictionary& d) {
+// Function to write an encoded file: the parts' codes in order, bit-packed at the dictionary's width
+//  Fails (leaving no file) if a code is not one of d's codes, e.g. -1 for a missing key.
+bool writeEncodedFile(const std::string& filepath_out, const std::vector<const std::vector<int>*>& parts,
+                      EncoderDictionary& d) {
+    size_t rows = 0;
+    for (const std::vector<int>* part : parts) {
+        rows += part->size();
+    }
+    EncodedColumnWriter writer(filepath_out, rows, encodedBitWidth(d.size()), d.checksum());
+    for (const std::vector<int>* part : parts) {
+        if (!writer.append(*part)) {
+            break;
+        }
+    }
+    return writer.close();
+}
+
+// Asynchronously process a portion of the input (a range of whole lines of the mapped file),
+//  form the correlated portion of dictionary d and encode it: addKey already returns each row's code
+void asyncProcessor(std::string_view range, EncoderDictionary& d, std::vector<int>& codes) {
+    forEachLine(range, [&](std::string_view line) {
+        codes.push_back(d.addKey(line)); // Mutex critical region. Must be multithread protected (see class)
+    });
+}
+
+// Form the dictionary itself, with keys as the original data and values as the encodings,
+//  and the encoded file in the same pass over the input
+//  num_threads = 0 uses every hardware thread
+//  sorted_codes renumbers the codes in key order before the files are written (see assignSortedCodes)
+void createDictionary(const std::string& filepath_in, const std::string& dictpath_out,
+                      const std::string& filepath_out, EncoderDictionary& d, size_t num_threads = 0,
+                      bool sorted_codes = false) {
     // Open and verify streams
     std::ofstream dict_out = openFileForWriting(dictpath_out);
-    std::ifstream file_in = openFileForReading(filepath_in);
 
-    // Prepare for multithreading split
-    const size_t num_threads = 1;//std::thread::hardware_concurrency(); // Get the number of available hardware threads
-    size_t line_count = 0;
-    std::string line;
-    while (std::getline(file_in, line)) {
-        ++line_count;
+    auto start = std::chrono::high_resolution_clock::now();
+    MappedFile file_in(filepath_in);
+
+    // Prepare for multithreading split (the sharded dictionary lets the threads run concurrently)
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency()); // Get the number of available hardware threads
     }
-    const size_t lines_per_thread = floor(line_count / num_threads);
     std::vector<std::thread> threads;
+    std::vector<std::vector<int>> codes(num_threads); // Encoded rows of each range
 
-    auto start = std::chrono::high_resolution_clock::now();
-
-    // Divide work over thread count and asynchronously build dictionary data structure
+    // Divide the file into one byte range per thread and asynchronously build dictionary data structure
+    std::vector<std::string_view> ranges = file_in.splitLines(num_threads);
     for (size_t i = 0; i < num_threads; ++i) {
-        size_t start = i * lines_per_thread;
-        size_t end = (i == num_threads-1) ? line_count : start + lines_per_thread;
-        threads.emplace_back([&, start, end](){ asyncProcessor(filepath_in, start, end, d); });
+        threads.emplace_back([&, i](){ asyncProcessor(ranges[i], d, codes[i]); });
     }
 
     // Synchronize all threads
@@ -140,11 +508,40 @@ void createDictionary(const std::string& filepath_in, const std::string& dictpat
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
     std::cout << "Encoding Complete. Time elapsed: " << duration.count() << " useconds." << std::endl;
 
-    // Contruct dictionary text file (singlethreaded, otherwise mutex issues)
-    for (const auto& entry : d.getDictionary()) {
-        dict_out << entry.first << ":" << entry.second << '\n';
+    // Report how often a thread had to wait for a shard lock
+    unsigned long long acquisitions = 0;
+    unsigned long long contended = 0;
+    unsigned long long worst = 0;
+    for (const ShardContention& shard : d.shardContention()) {
+        acquisitions += shard.acquisitions;
+        contended += shard.contended;
+        worst = std::max(worst, shard.contended);
     }
-    file_in.close();
+    std::cout << "Threads: " << num_threads << ", shard locks taken: " << acquisitions
+              << ", contended: " << contended << " (worst shard: " << worst << ")." << std::endl;
+
+    if (sorted_codes) {
+        std::vector<int> remap = d.assignSortedCodes();
+        for (std::vector<int>& range : codes) {
+            for (int& code : range) {
+                code = remap[code];
+            }
+        }
+    }
+
+    // Write the encoded column in range (file) order
+    std::vector<const std::vector<int>*> parts;
+    for (const std::vector<int>& range : codes) {
+        parts.push_back(&range);
+    }
+    if (!writeEncodedFile(filepath_out, parts, d)) {
+        return;
+    }
+
+    // Contruct dictionary text file (singlethreaded, otherwise mutex issues)
+    d.forEachSorted([&](std::string_view key, int value) {
+        dict_out << key << ":" << value << '\n';
+    });
     dict_out.flush();
     dict_out.close();
 
@@ -152,19 +549,75 @@ void createDictionary(const std::string& filepath_in, const std::string& dictpat
     return;
 }
 
-// Scan input file, perform encoding against existing dictionary, write to file
-void createEncodedFile(const std::string& filepath_in, const std::string& filepath_out, EncoderDictionary& d) {
-    std::ofstream file_out = openFileForWriting(filepath_out);
-    std::ifstream file_in = openFileForReading(filepath_in);
+// Phase 1 of the two-phase build: a private dictionary over a range of whole lines, no synchronization
+void asyncLocalProcessor(std::string_view range, ChunkDictionary& chunk) {
+    forEachLine(range, [&](std::string_view line) {
+        chunk.rowCodes.push_back(chunk.addKey(line)); // Thread-private, no lock
+    });
+    chunk.finish();
+}
 
-    std::string line;
-    while (std::getline(file_in, line)) {
-        int encoding = d.getEncoding(line);
-        file_out << encoding << '\n';
+// Form the dictionary and the encoded file with thread-local dictionaries and a deterministic merge
+//  Output is identical for any num_threads (0 uses every hardware thread).
+void createDictionaryTwoPhase(const std::string& filepath_in, const std::string& dictpath_out,
+                              const std::string& filepath_out, EncoderDictionary& d, size_t num_threads = 0,
+                              bool sorted_codes = false) {
+    // Open and verify streams
+    std::ofstream dict_out = openFileForWriting(dictpath_out);
+
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
     }
-    file_in.close();
-    file_out.flush();
-    file_out.close();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    MappedFile file_in(filepath_in);
+
+    // Phase 1: every thread builds a private dictionary over its byte range (ranges are in file order)
+    std::vector<std::string_view> ranges = file_in.splitLines(num_threads);
+    std::vector<ChunkDictionary> chunks(num_threads);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&, i](){ asyncLocalProcessor(ranges[i], chunks[i]); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto built = std::chrono::high_resolution_clock::now();
+
+    // Phases 2 and 3: merge into global codes and remap the chunks
+    d.mergeChunks(chunks, num_threads);
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto buildTime = std::chrono::duration_cast<std::chrono::microseconds>(built - start);
+    auto mergeTime = std::chrono::duration_cast<std::chrono::microseconds>(stop - built);
+    std::cout << "Encoding Complete. Time elapsed: " << (buildTime + mergeTime).count() << " useconds ("
+              << buildTime.count() << " local build, " << mergeTime.count() << " merge + remap, "
+              << num_threads << " threads)." << std::endl;
+
+    if (sorted_codes) {
+        std::vector<int> remap = d.assignSortedCodes();
+        for (ChunkDictionary& chunk : chunks) {
+            for (int& code : chunk.rowCodes) {
+                code = remap[code];
+            }
+        }
+    }
+
+    // Write the encoded column in chunk order, then the dictionary
+    std::vector<const std::vector<int>*> parts;
+    for (const ChunkDictionary& chunk : chunks) {
+        parts.push_back(&chunk.rowCodes);
+    }
+    if (!writeEncodedFile(filepath_out, parts, d)) {
+        return;
+    }
+    d.forEachSorted([&](std::string_view key, int value) {
+        dict_out << key << ":" << value << '\n';
+    });
+    dict_out.flush();
+    dict_out.close();
+
+    std::cout << "DICTIONARY CREATED." << '\n';
 }
 
 // Function to read in an existing dictionary file for use with an encoded file
@@ -174,36 +627,42 @@ void readDictionary(const std::string& dictpath_in, EncoderDictionary& d) {
     std::string line;
     while (std::getline(dict_in, line)) {
         size_t kvp_split = line.find(':');
-        std::string key = line.substr(0, kvp_split);
+        std::string_view key = std::string_view(line).substr(0, kvp_split);
         int val = std::stoi(line.substr(kvp_split+1));
-        d.getDictionary()[key] = val;
+        d.setKey(key, val);
     }
 }
 
-// Function to read a vanilla column file and throw it in DRAM
-void readInputFile(const std::string& filepath_in, std::vector<std::string>& input_data) {
+// Function to read a vanilla column file and throw it in DRAM (one arena, no allocation per row)
+void readInputFile(const std::string& filepath_in, StringArena& input_data) {
     std::ifstream file_in = openFileForReading(filepath_in);
     std::string line;
     while (std::getline(file_in, line)) {
-        input_data.push_back(line);
+        input_data.append(line);
     }
+    input_data.shrinkToFit();
     file_in.close();
 }
 
-// Functon to read an encoded file and throw it in DRAM
-void readEncodedFile(const std::string& filepath_in_enc, std::vector<int>& encoded_data) {
-    std::ifstream file_in_enc = openFileForReading(filepath_in_enc);
-    std::string line;
-    while (std::getline(file_in_enc, line)) {
-        encoded_data.push_back(std::stoi(line));
+// Functon to read an encoded file and throw it in DRAM (mapped and unpacked; no text parsing)
+//  Fails if the file is not an encoded column or was written with a different dictionary than d.
+bool readEncodedFile(const std::string& filepath_in_enc, std::vector<int>& encoded_data, EncoderDictionary& d) {
+    EncodedColumn column(filepath_in_enc);
+    if (!column.isValid()) {
+        return false;
+    }
+    if (column.dictionaryChecksum() != d.checksum()) {
+        std::cerr << "Error: " << filepath_in_enc << " was encoded with a different dictionary" << '\n';
+        return false;
     }
-    file_in_enc.close();
+    column.unpack(encoded_data);
+    return true;
 }
 
 // ____ SEARCHING FUNCTIONS ____ //
 
 // Function to perform a vanilla search on raw input in memory
-bool searchInput(const std::vector<std::string>& input_data, std::string target, std::vector<int>& target_locations) {
+bool searchInput(const StringArena& input_data, std::string_view target, std::vector<int>& target_locations) {
     for (size_t i = 0; i < input_data.size(); ++i) {
         if (input_data[i] == target) {
             target_locations.push_back(i);
@@ -213,7 +672,7 @@ bool searchInput(const std::vector<std::string>& input_data, std::string target,
 }
 
 // Function to perform a vanilla PREFIX search on raw input in memory
-bool prefixSearchInput(const std::vector<std::string>& input_data, std::string target_prefix, std::vector<int>& target_locations) {
+bool prefixSearchInput(const StringArena& input_data, std::string_view target_prefix, std::vector<int>& target_locations) {
     for (size_t i = 0; i < input_data.size(); ++i) {
         // Check to see if the prefix is present for the currently examined column index
         if (input_data[i].compare(0, target_prefix.length(), target_prefix) == 0) {
@@ -272,8 +731,9 @@ bool searchEncodedSIMD(const std::vector<int>& encoded_data, EncoderDictionary&
     // Convert the target encoding to a vector for SIMD comparison
     __m128i target_vec = _mm_set1_epi32(target_encoding);
 
-    // Loop over encodings with SIMD this time
-    for (size_t i = 0; i < encoded_data.size(); i += 4) {
+    // Loop over encodings with SIMD this time (whole groups of 4 only)
+    size_t i = 0;
+    for (; i + 4 <= encoded_data.size(); i += 4) {
         // Load 4 integers from encoded_data into a SIMD register
         __m128i data_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&encoded_data[i]));
 
@@ -292,6 +752,12 @@ bool searchEncodedSIMD(const std::vector<int>& encoded_data, EncoderDictionary&
             }
         }
     }
+    // Scalar tail: the last size % 4 rows (a 4-wide load there would read past the vector)
+    for (; i < encoded_data.size(); ++i) {
+        if (encoded_data[i] == target_encoding) {
+            target_locations.push_back(i);
+        }
+    }
     return true;
 }
 
@@ -309,8 +775,9 @@ bool prefixSearchEncodedSIMD(const std::vector<int>& encoded_data, EncoderDictio
         target_vecs.push_back(_mm_set1_epi32(target_encodings[i]));
     }
 
-    // Loop over encodings with SIMD this time
-    for (size_t i = 0; i < encoded_data.size(); i += 4) {
+    // Loop over encodings with SIMD this time (whole groups of 4 only)
+    size_t i = 0;
+    for (; i + 4 <= encoded_data.size(); i += 4) {
         // Load 4 integers from encoded_data into a SIMD register
         __m128i data_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&encoded_data[i]));
 
@@ -331,5 +798,73 @@ bool prefixSearchEncodedSIMD(const std::vector<int>& encoded_data, EncoderDictio
             }
         }
     }
+    // Scalar tail, in the same order (target by target within a row group)
+    for (size_t j = 0; j < target_encodings.size(); ++j) {
+        for (size_t r = i; r < encoded_data.size(); ++r) {
+            if (encoded_data[r] == target_encodings[j]) {
+                target_locations.push_back(r);
+            }
+        }
+    }
     return true;
-}
\ No newline at end of file
+}
+
+// SIMD scan for codes in [lo, hi): two compares per element, however many keys the interval covers
+void rangeSearchEncodedSIMD(const std::vector<int>& encoded_data, int lo, int hi, std::vector<int>& target_locations) {
+    if (lo >= hi) {
+        return;
+    }
+    __m256i below = _mm256_set1_epi32(lo - 1); // code > lo - 1
+    __m256i above = _mm256_set1_epi32(hi);     // code < hi
+    size_t i = 0;
+    for (; i + 8 <= encoded_data.size(); i += 8) {
+        __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&encoded_data[i]));
+        __m256i inside = _mm256_and_si256(_mm256_cmpgt_epi32(data_vec, below), _mm256_cmpgt_epi32(above, data_vec));
+        unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(inside));
+        while (mask != 0) {
+            target_locations.push_back(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+    for (; i < encoded_data.size(); ++i) {
+        if (encoded_data[i] >= lo && encoded_data[i] < hi) {
+            target_locations.push_back(i);
+        }
+    }
+}
+
+// PREFIX search of an encoded column with order-preserving codes (one code interval)
+bool prefixSearchEncodedRange(const std::vector<int>& encoded_data, EncoderDictionary& d, const std::string& target_prefix, std::vector<int>& target_locations) {
+    int lo = 0;
+    int hi = 0;
+    if (!d.getCodeRangeWithPrefix(target_prefix, lo, hi) || lo == hi) {
+        return false;
+    }
+    rangeSearchEncodedSIMD(encoded_data, lo, hi, target_locations);
+    return true;
+}
+
+// Search of a bit-sliced column for a target (predicate evaluated on the packed codes, then rows listed)
+bool searchEncodedPacked(const BitSlicedColumn& column, EncoderDictionary& d, const std::string& target, std::vector<int>& target_locations) {
+    int target_encoding = d.getEncoding(target);
+    if (target_encoding == -1) {
+        return false;
+    }
+    std::vector<std::uint64_t> bitmap;
+    column.equalTo(static_cast<std::uint32_t>(target_encoding), bitmap);
+    bitmapToLocations(bitmap, target_locations);
+    return true;
+}
+
+// PREFIX search of a bit-sliced column with order-preserving codes (one packed range predicate)
+bool prefixSearchEncodedPacked(const BitSlicedColumn& column, EncoderDictionary& d, const std::string& target_prefix, std::vector<int>& target_locations) {
+    int lo = 0;
+    int hi = 0;
+    if (!d.getCodeRangeWithPrefix(target_prefix, lo, hi) || lo == hi) {
+        return false;
+    }
+    std::vector<std::uint64_t> bitmap;
+    column.inRange(static_cast<std::uint32_t>(lo), static_cast<std::uint32_t>(hi), bitmap);
+    bitmapToLocations(bitmap, target_locations);
+    return true;
+}
@@ -0,0 +1,111 @@
+//
+// file: MappedFile.h
+// desc: ACS Project 4 Mapped File Header
+// auth: Andrew Prata
+//
+// This program implements read-only memory mapping of
+// a column file. The file is split into byte ranges
+// that start on line boundaries, so each thread can
+// parse its own range in place: no line counting pass,
+// no seeking, and no copy of each line into a string.
+//
+
+#pragma once
+
+#include <algorithm>   // std::max
+#include <iostream>    // std::cerr
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+#include <cstring>     // std::memchr
+#include <fcntl.h>     // open()
+#include <sys/mman.h>  // mmap()/munmap()/madvise()
+#include <sys/stat.h>  // fstat()
+#include <unistd.h>    // close()
+
+// Read-only view of a whole file, mapped into memory (unmapped on destruction)
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+    bool open = false;
+
+public:
+    explicit MappedFile(const std::string& filepath) {
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            std::cerr << "Error: Could not open the file " << filepath << '\n';
+            if (fd >= 0) {
+                close(fd);
+            }
+            return;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) { // mmap rejects empty mappings; an empty file is just zero lines
+            void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                std::cerr << "Error: Could not map the file " << filepath << '\n';
+                close(fd);
+                length = 0;
+                return;
+            }
+            data = static_cast<const char*>(mapped);
+            madvise(mapped, length, MADV_SEQUENTIAL); // Every range is read front to back
+        }
+        close(fd); // The mapping keeps the file alive
+        open = true;
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), length);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const {
+        return open;
+    }
+
+    std::string_view bytes() const {
+        return std::string_view(data, length);
+    }
+
+    // Function to split the file into n byte ranges of about equal size, each starting on a line
+    //  Range i starts at the first line that begins at or after byte i * size / n, so every line
+    //  lands in exactly one range (some ranges may be empty when lines are long).
+    std::vector<std::string_view> splitLines(size_t n) const {
+        std::vector<size_t> starts(n + 1, length);
+        starts[0] = 0;
+        for (size_t i = 1; i < n; ++i) {
+            size_t target = std::max(starts[i - 1], (i * length) / n);
+            if (target == 0 || target >= length || data[target - 1] == '\n') {
+                starts[i] = target; // Already on a line start
+                continue;
+            }
+            const void* newline = std::memchr(data + target, '\n', length - target);
+            starts[i] = (newline == nullptr) ? length : static_cast<const char*>(newline) - data + 1;
+        }
+        std::vector<std::string_view> ranges(n);
+        for (size_t i = 0; i < n; ++i) {
+            ranges[i] = std::string_view(data + starts[i], starts[i + 1] - starts[i]);
+        }
+        return ranges;
+    }
+};
+
+// Function to visit every line of a byte range in place (same lines as std::getline would give)
+template <typename F>
+void forEachLine(std::string_view range, F visit) {
+    const char* cursor = range.data();
+    const char* end = range.data() + range.size();
+    while (cursor < end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* lineEnd = (newline == nullptr) ? end : newline;
+        visit(std::string_view(cursor, lineEnd - cursor));
+        cursor = lineEnd + 1;
+    }
+}
@@ -0,0 +1,79 @@
+//
+// file: StringArena.h
+// desc: ACS Project 4 String Arena Header
+// auth: Andrew Prata
+//
+// This program implements an append-only store for
+// many short strings (Arrow-style offsets + bytes).
+// Every string lives back to back in one byte buffer,
+// so there is no heap allocation per string and a
+// scan over the strings reads memory sequentially.
+//
+
+#pragma once
+
+#include <algorithm>   // std::max
+#include <cstdint>     // std::uint64_t
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+// Append-only sequence of strings: string i is bytes[offsets[i], offsets[i + 1])
+//  Views returned by operator[] stay valid until the next append (which may move the bytes).
+class StringArena {
+private:
+    std::vector<char> bytes;
+    std::vector<std::uint64_t> offsets = {0};
+
+public:
+    // Function to append a string; returns its index
+    size_t append(std::string_view s) {
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        offsets.push_back(bytes.size());
+        return offsets.size() - 2;
+    }
+
+    std::string_view operator[](size_t i) const {
+        return std::string_view(bytes.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    size_t size() const {
+        return offsets.size() - 1;
+    }
+
+    // Function to pre-size the arena for n strings totalling byteCount bytes
+    void reserve(size_t n, size_t byteCount) {
+        offsets.reserve(n + 1);
+        bytes.reserve(byteCount);
+    }
+
+    // Function to release spare capacity once no more strings will be appended
+    void shrinkToFit() {
+        bytes.shrink_to_fit();
+        offsets.shrink_to_fit();
+    }
+
+    // Total length of the stored strings
+    size_t byteSize() const {
+        return bytes.size();
+    }
+
+    // Bytes of storage (string bytes plus offsets, including spare capacity)
+    size_t memoryBytes() const {
+        return bytes.capacity() + offsets.capacity() * sizeof(std::uint64_t);
+    }
+
+    // Function to estimate the footprint of the same strings as a std::vector<std::string>
+    //  One std::string object per string, plus a heap block for strings past the small-string
+    //  buffer (rounded to the allocator's 16-byte chunks with its 8-byte header).
+    size_t stringVectorBytes() const {
+        size_t total = size() * sizeof(std::string);
+        for (size_t i = 0; i < size(); ++i) {
+            size_t length = offsets[i + 1] - offsets[i];
+            if (length > 15) {
+                total += std::max<size_t>(32, (length + 1 + 8 + 15) / 16 * 16);
+            }
+        }
+        return total;
+    }
+};
@@ -0,0 +1,390 @@
+//
+// file: SuccinctTrie.h
+// desc: ACS Project 4 Succinct Trie Header
+// auth: Andrew Prata
+//
+// This program implements a static, compressed trie
+// over the finished dictionary (LOUDS-Sparse layout,
+// as in fast succinct tries). Each edge costs one label
+// byte plus two bits, and every pointer is replaced by
+// a rank/select query over those bits. Once a branch
+// holds a single key, the rest of that key is stored
+// as a packed tail instead of one edge per byte.
+//
+
+#pragma once
+
+#include "BitVector.h" // Rank/select bits and packed integers
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+#include <algorithm>   // std::reverse
+
+// Static trie mapping keys to codes: exact lookup, prefix enumeration and decode by code
+//  Internal nodes are numbered in breadth-first order; edge e belongs to node rank1(louds, e + 1) - 1
+//  and, when hasChild(e) is set, leads to internal node rank1(hasChild, e + 1). A key ends either on
+//  an edge without a child (a leaf) or at an internal node flagged in prefixKey. Leaf k owns the
+//  remaining bytes of its key (its tail, possibly empty), stored back to back in tails. Tail offsets
+//  are Elias-Fano coded: offset k is ((select1(tailHigh, k) - k) << tailLowBits) | tailLow[k], which
+//  costs about 2 + log2(average tail length) bits per leaf.
+//  Codes in any order need a map in each direction between codes and terminals (leaves and prefix
+//  nodes). When code i is the i-th smallest key, a key's code is its rank instead: the walk from the
+//  root adds it up from the key counts of the subtrees it passes, and no per-key map is kept.
+class SuccinctTrie {
+private:
+    std::vector<unsigned char> labels; // Edge labels, sorted within each node
+    BitVector hasChild;                // Per edge: leads to an internal node
+    BitVector louds;                   // Per edge: first edge of its node
+    BitVector prefixKey;               // Per internal node: a key ends here
+    std::vector<char> tails;           // Leaf tails, back to back in leaf order
+    BitVector tailHigh;                // Per tail offset: a 1 after (offset >> tailLowBits) 0s in total
+    PackedArray tailLow;               // Per tail offset: its low tailLowBits bits
+    unsigned tailLowBits = 0;
+    PackedArray terminalCodes;         // Terminal id -> code (leaves first, then prefix nodes)
+    PackedArray codeTerminals;         // Code -> terminal id (for decoding)
+    PackedArray keysBefore;            // Codes in key order only: keys under internal nodes < v, summed
+    bool codesInKeyOrder = false;      // Set by build when code i is the i-th smallest key
+    size_t leafCount = 0;
+    size_t nodeCount = 0;
+    size_t keyCount = 0;
+
+    // First edge of internal node v, and one past its last edge
+    size_t edgeBegin(size_t v) const {
+        return louds.select1(v);
+    }
+
+    // One past the last edge of the node whose edges start at begin (the next louds bit)
+    size_t edgeEnd(size_t begin) const {
+        return louds.nextOne(begin + 1);
+    }
+
+    // Helper to find the edge labelled c among the edges starting at begin (labels.size() if none)
+    size_t findEdge(size_t begin, unsigned char c) const {
+        if (begin >= labels.size()) {
+            return labels.size(); // Edgeless root
+        }
+        size_t end = edgeEnd(begin);
+        auto it = std::lower_bound(labels.begin() + begin, labels.begin() + end, c);
+        return (it != labels.begin() + end && *it == c) ? it - labels.begin() : labels.size();
+    }
+
+    // Helper to get the tail of leaf k (the key bytes after its edge label)
+    std::string_view tail(size_t k) const {
+        size_t bit = tailHigh.select1(k);
+        size_t next = tailHigh.nextOne(bit + 1); // Offset k + 1 is where the tail ends
+        size_t start = ((bit - k) << tailLowBits) | tailLow.get(k);
+        size_t end = ((next - k - 1) << tailLowBits) | tailLow.get(k + 1);
+        return std::string_view(tails.data() + start, end - start);
+    }
+
+    // Helper to count the keys under internal nodes [first, last)
+    size_t subtreeKeys(size_t first, size_t last) const {
+        return keysBefore.get(last) - keysBefore.get(first);
+    }
+
+    // Helper for codes in key order: the keys of node v's subtree that sort before its edge e
+    //  (v's own key, the leaves among its earlier edges and the subtrees of the others). nextChild is
+    //  hasChild.rank1(e) + 1, the first internal node reached through an edge at or after e.
+    size_t keysBeforeEdge(size_t v, size_t begin, size_t e, size_t nextChild) const {
+        size_t firstChild = hasChild.rank1(begin) + 1;
+        return prefixKey.get(v) + (e - begin) - (nextChild - firstChild) + subtreeKeys(firstChild, nextChild);
+    }
+
+    // Helper to decode when codes are in key order: walk down, skipping subtrees by their key counts
+    std::string decodeRank(size_t rank) const {
+        std::string key;
+        size_t v = 0;
+        while (true) {
+            if (prefixKey.get(v)) {
+                if (rank == 0) {
+                    return key;
+                }
+                --rank;
+            }
+            size_t begin = edgeBegin(v);
+            size_t child = hasChild.rank1(begin); // Internal nodes entered through edges before e
+            size_t below = keysBefore.get(child + 1);
+            bool descended = false;
+            for (size_t e = begin, end = edgeEnd(begin); e < end && !descended; ++e) {
+                if (hasChild.get(e)) {
+                    size_t above = below;
+                    below = keysBefore.get(++child + 1);
+                    if (rank < below - above) {
+                        key.push_back(labels[e]);
+                        v = child;
+                        descended = true;
+                    } else {
+                        rank -= below - above;
+                    }
+                } else if (rank == 0) {
+                    key.push_back(labels[e]);
+                    key.append(tail(e - child)); // Leaf rank = edges before e without a child
+                    return key;
+                } else {
+                    --rank;
+                }
+            }
+            if (!descended) {
+                return key; // Not reached for rank < size()
+            }
+        }
+    }
+
+    // Helper to append the codes under node v (whose edges start at begin) in key order
+    //  child is hasChild.rank1(begin); the return value is the same count past the node's last edge,
+    //  which is where the next sibling's edges start, so a subtree needs one rank and one select per
+    //  level instead of one per node.
+    size_t collect(size_t v, size_t begin, size_t child, std::vector<int>& codes) const {
+        if (prefixKey.get(v)) {
+            codes.push_back(terminalCodes.get(leafCount + prefixKey.rank1(v)));
+        }
+        if (begin >= labels.size()) {
+            return child;
+        }
+        size_t childBegin = labels.size(); // Children of consecutive edges are consecutive nodes,
+        size_t grandchild = 0;             // and their edge ranges are consecutive too
+        for (size_t e = begin, end = edgeEnd(begin); e < end; ++e) {
+            if (hasChild.get(e)) {
+                if (childBegin == labels.size()) {
+                    childBegin = edgeBegin(child + 1);
+                    grandchild = hasChild.rank1(childBegin);
+                } else {
+                    childBegin = edgeEnd(childBegin);
+                }
+                grandchild = collect(++child, childBegin, grandchild, codes);
+            } else {
+                codes.push_back(terminalCodes.get(e - child)); // Leaf rank = edges before e without a child
+            }
+        }
+        return child;
+    }
+
+public:
+    // Function to build the trie from keys in sorted order and their codes (codes must be < keys.size())
+    //  Codes 0, 1, 2, ... in key order are recognized and kept as subtree key counts instead of maps.
+    void build(const std::vector<std::string_view>& keys, const std::vector<int>& codes) {
+        struct Range {
+            size_t lo;
+            size_t hi;
+            size_t depth;
+        };
+        std::vector<int> leafValues;
+        std::vector<int> nodeValues;
+        std::vector<size_t> tailOffsets;
+        std::vector<Range> level = {{0, keys.size(), 0}};
+        // Breadth first: every range is one internal node (keys sharing their first `depth` bytes)
+        for (size_t next = 0; next < level.size(); ++next) {
+            Range node = level[next];
+            size_t i = node.lo;
+            bool endsHere = i < node.hi && keys[i].size() == node.depth; // Sorted, so it comes first
+            prefixKey.push(endsHere);
+            if (endsHere) {
+                nodeValues.push_back(codes[i++]);
+            }
+            bool first = true;
+            while (i < node.hi) {
+                unsigned char c = keys[i][node.depth];
+                size_t j = i + 1;
+                while (j < node.hi && static_cast<unsigned char>(keys[j][node.depth]) == c) {
+                    ++j;
+                }
+                labels.push_back(c);
+                louds.push(first);
+                first = false;
+                bool leaf = (j == i + 1); // A single key: the rest of it becomes the leaf's tail
+                hasChild.push(!leaf);
+                if (leaf) {
+                    leafValues.push_back(codes[i]);
+                    std::string_view rest = keys[i].substr(node.depth + 1);
+                    tailOffsets.push_back(tails.size());
+                    tails.insert(tails.end(), rest.begin(), rest.end());
+                } else {
+                    level.push_back({i, j, node.depth + 1});
+                }
+                i = j;
+            }
+            // Only the root can end up without edges (no keys, or just the empty key)
+        }
+        nodeCount = level.size();
+        hasChild.buildRank();
+        louds.buildRank();
+        prefixKey.buildRank();
+        tails.shrink_to_fit();
+
+        // Elias-Fano tail offsets (plus the end of the last tail): the low bits cover the average tail
+        tailOffsets.push_back(tails.size());
+        tailLowBits = 0;
+        while ((tailOffsets.size() << (tailLowBits + 1)) <= tails.size()) {
+            ++tailLowBits;
+        }
+        tailLow = PackedArray(tailOffsets.size(), tailLowBits);
+        for (size_t k = 0; k < tailOffsets.size(); ++k) {
+            while (tailHigh.size() < (tailOffsets[k] >> tailLowBits) + k) {
+                tailHigh.push(false);
+            }
+            tailHigh.push(true);
+            tailLow.set(k, tailOffsets[k]);
+        }
+        tailHigh.buildRank();
+
+        leafCount = leafValues.size();
+        keyCount = keys.size();
+        codesInKeyOrder = true;
+        for (size_t i = 0; i < keys.size() && codesInKeyOrder; ++i) {
+            codesInKeyOrder = codes[i] == static_cast<int>(i);
+        }
+        if (codesInKeyOrder) {
+            // Each internal node is the range of keys sharing its path, so its key count is the width
+            size_t total = 0;
+            for (const Range& node : level) {
+                total += node.hi - node.lo;
+            }
+            keysBefore = PackedArray(nodeCount + 1, PackedArray::bitsFor(total));
+            total = 0;
+            for (size_t v = 0; v < nodeCount; ++v) {
+                keysBefore.set(v, total);
+                total += level[v].hi - level[v].lo;
+            }
+            keysBefore.set(nodeCount, total);
+            return;
+        }
+        size_t terminals = leafCount + nodeValues.size();
+        unsigned codeBits = PackedArray::bitsFor(keys.size());
+        terminalCodes = PackedArray(terminals, codeBits);
+        codeTerminals = PackedArray(keys.size(), PackedArray::bitsFor(terminals));
+        for (size_t t = 0; t < terminals; ++t) {
+            int code = (t < leafCount) ? leafValues[t] : nodeValues[t - leafCount];
+            terminalCodes.set(t, code);
+            codeTerminals.set(code, t);
+        }
+    }
+
+    // Function to look up the code of a key (-1 if absent)
+    int getEncoding(std::string_view key) const {
+        if (nodeCount == 0) {
+            return -1;
+        }
+        size_t v = 0;
+        size_t rank = 0; // Codes in key order: keys sorting before v's subtree
+        for (size_t d = 0; d < key.size(); ++d) {
+            size_t begin = edgeBegin(v);
+            size_t e = findEdge(begin, key[d]);
+            if (e == labels.size()) {
+                return -1;
+            }
+            if (!hasChild.get(e)) {
+                size_t k = hasChild.rank0(e);
+                if (tail(k) != key.substr(d + 1)) {
+                    return -1;
+                }
+                return static_cast<int>(codesInKeyOrder ? rank + keysBeforeEdge(v, begin, e, e - k + 1)
+                                                        : terminalCodes.get(k));
+            }
+            size_t child = hasChild.rank1(e + 1);
+            if (codesInKeyOrder) {
+                rank += keysBeforeEdge(v, begin, e, child);
+            }
+            v = child;
+        }
+        if (!prefixKey.get(v)) {
+            return -1;
+        }
+        return static_cast<int>(codesInKeyOrder ? rank : terminalCodes.get(leafCount + prefixKey.rank1(v)));
+    }
+
+    // Function to return the codes of every key starting with prefix, in key order
+    std::vector<int> getEncodingValuesWithPrefix(std::string_view prefix) const {
+        std::vector<int> codes;
+        if (nodeCount == 0) {
+            return codes;
+        }
+        size_t v = 0;
+        size_t rank = 0; // Codes in key order: keys sorting before v's subtree
+        for (size_t d = 0; d < prefix.size(); ++d) {
+            size_t begin = edgeBegin(v);
+            size_t e = findEdge(begin, prefix[d]);
+            if (e == labels.size()) {
+                return codes;
+            }
+            if (!hasChild.get(e)) {
+                size_t k = hasChild.rank0(e);
+                if (tail(k).starts_with(prefix.substr(d + 1))) { // The only key below this edge
+                    codes.push_back(codesInKeyOrder ? rank + keysBeforeEdge(v, begin, e, e - k + 1)
+                                                    : terminalCodes.get(k));
+                }
+                return codes;
+            }
+            size_t child = hasChild.rank1(e + 1);
+            if (codesInKeyOrder) {
+                rank += keysBeforeEdge(v, begin, e, child);
+            }
+            v = child;
+        }
+        if (codesInKeyOrder) {
+            // The subtree's keys are consecutive in key order, and so are their codes
+            for (size_t code = rank, end = rank + subtreeKeys(v, v + 1); code < end; ++code) {
+                codes.push_back(static_cast<int>(code));
+            }
+            return codes;
+        }
+        size_t begin = edgeBegin(v);
+        collect(v, begin, hasChild.rank1(begin), codes);
+        return codes;
+    }
+
+    // Function to recover the key with a given code (empty if the code is out of range)
+    std::string decode(int code) const {
+        std::string key;
+        if (code < 0 || static_cast<size_t>(code) >= keyCount) {
+            return key;
+        }
+        if (codesInKeyOrder) {
+            return decodeRank(code);
+        }
+        size_t terminal = codeTerminals.get(code);
+        size_t v;
+        std::string_view rest;
+        if (terminal < leafCount) {
+            size_t e = hasChild.select0(terminal); // The leaf edge
+            key.push_back(labels[e]);
+            v = louds.rank1(e + 1) - 1;
+            rest = tail(terminal);
+        } else {
+            v = prefixKey.select1(terminal - leafCount);
+        }
+        // Climb to the root: internal node v > 0 is entered through the v-th child edge
+        while (v != 0) {
+            size_t e = hasChild.select1(v - 1);
+            key.push_back(labels[e]);
+            v = louds.rank1(e + 1) - 1;
+        }
+        std::reverse(key.begin(), key.end());
+        key.append(rest);
+        return key;
+    }
+
+    size_t size() const {
+        return keyCount;
+    }
+
+    // Whether code i is the i-th smallest key (so no code maps are stored)
+    bool hasCodesInKeyOrder() const {
+        return codesInKeyOrder;
+    }
+
+    // Bytes of storage for the trie shape, labels and tails
+    size_t structureBytes() const {
+        return labels.size() + hasChild.memoryBytes() + louds.memoryBytes() + prefixKey.memoryBytes() +
+               tails.size() + tailHigh.memoryBytes() + tailLow.memoryBytes();
+    }
+
+    // Bytes of storage for finding codes: the terminal <-> code maps, or the subtree key counts
+    size_t codeBytes() const {
+        return terminalCodes.memoryBytes() + codeTerminals.memoryBytes() + keysBefore.memoryBytes();
+    }
+
+    // Bytes of storage for the whole structure
+    size_t memoryBytes() const {
+        return structureBytes() + codeBytes();
+    }
+};
@@ -0,0 +1,209 @@
+//
+// file: SwissTable.h
+// desc: ACS Project 4 Hash Table Header
+// auth: Andrew Prata
+//
+// This program implements the open-addressing hash
+// table behind the encoding dictionary. Slots are
+// probed 16 at a time through a byte of metadata per
+// slot (Swiss table style): one SSE2 compare finds the
+// candidate slots in a group, so most lookups touch a
+// single cache line of metadata and a single key.
+// Key bytes live in one arena per table; a slot holds
+// only the hash, the key's arena index and the value.
+//
+
+#pragma once
+
+#include "StringArena.h" // Key storage
+#include <cstdint>       // std::uint64_t
+#include <cstring>       // std::memcpy
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <utility>       // std::pair/std::move
+#include <vector>        // std::vector
+#include <emmintrin.h>   // SSE2 intrinsics
+
+// Function to hash a key, 8 bytes per step (computed once per key, then reused for every probe)
+inline std::uint64_t hashKey(std::string_view key) {
+    const std::uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    const char* bytes = key.data();
+    size_t length = key.size();
+    std::uint64_t hash = length * multiplier;
+    auto mix = [](std::uint64_t word) {
+        word *= 0xBF58476D1CE4E5B9ull;
+        return word ^ (word >> 31);
+    };
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ mix(word)) * multiplier;
+    }
+    if (i < length) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes + i, length - i);
+        hash = (hash ^ mix(word)) * multiplier;
+    }
+    hash ^= hash >> 32;
+    hash *= 0x94D049BB133111EBull;
+    return hash ^ (hash >> 29);
+}
+
+// Open-addressing map from key to code, probed one 16-slot group at a time
+class SwissTable {
+private:
+    static constexpr size_t groupWidth = 16;
+    static constexpr signed char emptyControl = -128; // High bit set = empty; full slots hold 7 hash bits
+
+    struct Slot {
+        std::uint64_t hash = 0; // Kept so growth never rehashes a string
+        std::uint32_t key = 0;  // Index into keys
+        int value = 0;
+    };
+
+    std::vector<signed char> control; // One metadata byte per slot
+    std::vector<Slot> slots;
+    StringArena keys;                 // Key bytes, in insertion order
+    size_t groupMask = 0;             // Number of groups - 1 (a power of two)
+    size_t count = 0;
+
+    static signed char controlByte(std::uint64_t hash) {
+        return static_cast<signed char>(hash & 0x7F);
+    }
+
+    // Helper to locate a key: the slot index if present, otherwise -1 and the first free slot
+    long long probe(std::string_view key, std::uint64_t hash, size_t& freeSlot) const {
+        __m128i tag = _mm_set1_epi8(controlByte(hash));
+        size_t group = (hash >> 7) & groupMask;
+        for (size_t step = 1; ; ++step) {
+            const signed char* metadata = control.data() + group * groupWidth;
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(metadata));
+            unsigned matches = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, tag));
+            while (matches != 0) {
+                size_t slot = group * groupWidth + __builtin_ctz(matches);
+                if (slots[slot].hash == hash && keys[slots[slot].key] == key) {
+                    return static_cast<long long>(slot);
+                }
+                matches &= matches - 1;
+            }
+            unsigned empties = _mm_movemask_epi8(bytes); // Sign bit = empty
+            if (empties != 0) {
+                freeSlot = group * groupWidth + __builtin_ctz(empties);
+                return -1;
+            }
+            group = (group + step) & groupMask; // Triangular probing visits every group
+        }
+    }
+
+    // Helper to find the first free slot on a hash's probe sequence (used while regrouping)
+    size_t freeSlotFor(std::uint64_t hash) const {
+        size_t group = (hash >> 7) & groupMask;
+        for (size_t step = 1; ; ++step) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control.data() + group * groupWidth));
+            unsigned empties = _mm_movemask_epi8(bytes);
+            if (empties != 0) {
+                return group * groupWidth + __builtin_ctz(empties);
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    void grow() {
+        std::vector<Slot> oldSlots = std::move(slots);
+        std::vector<signed char> oldControl = std::move(control);
+        size_t groups = oldControl.empty() ? 1 : 2 * (groupMask + 1);
+        control.assign(groups * groupWidth, emptyControl);
+        slots.assign(groups * groupWidth, Slot{});
+        groupMask = groups - 1;
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldControl[i] != emptyControl) {
+                size_t freeSlot = freeSlotFor(oldSlots[i].hash); // Keys are unique, so no compare is needed
+                control[freeSlot] = controlByte(oldSlots[i].hash);
+                slots[freeSlot] = std::move(oldSlots[i]);
+            }
+        }
+    }
+
+public:
+    // Function to look up a key whose hash is already known (nullptr if absent)
+    const int* find(std::string_view key, std::uint64_t hash) const {
+        if (count == 0) {
+            return nullptr;
+        }
+        size_t freeSlot = 0;
+        long long slot = probe(key, hash, freeSlot);
+        return slot < 0 ? nullptr : &slots[slot].value;
+    }
+
+    // Function to insert a key if absent; returns its value slot and whether it was inserted
+    std::pair<int*, bool> insert(std::string_view key, std::uint64_t hash, int value) {
+        if ((count + 1) * 8 > slots.size() * 7) { // Keep the load factor under 7/8
+            grow();
+        }
+        size_t freeSlot = 0;
+        long long slot = probe(key, hash, freeSlot);
+        if (slot >= 0) {
+            return {&slots[slot].value, false};
+        }
+        control[freeSlot] = controlByte(hash);
+        slots[freeSlot].hash = hash;
+        slots[freeSlot].key = static_cast<std::uint32_t>(keys.append(key));
+        slots[freeSlot].value = value;
+        ++count;
+        return {&slots[freeSlot].value, true};
+    }
+
+    // Function to pre-size the table for n keys
+    void reserve(size_t n) {
+        while (n * 8 > slots.size() * 7) {
+            grow();
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Slot-level access (slot indices stay valid until the next insert that grows the table)
+    size_t slotCount() const {
+        return slots.size();
+    }
+
+    bool occupied(size_t slot) const {
+        return control[slot] != emptyControl;
+    }
+
+    // Key of a slot (the view stays valid until the next insert)
+    std::string_view keyAt(size_t slot) const {
+        return keys[slots[slot].key];
+    }
+
+    int valueAt(size_t slot) const {
+        return slots[slot].value;
+    }
+
+    int& valueAt(size_t slot) {
+        return slots[slot].value;
+    }
+
+    std::uint64_t hashAt(size_t slot) const {
+        return slots[slot].hash;
+    }
+
+    // Bytes of storage (metadata, slots and key arena)
+    size_t memoryBytes() const {
+        return control.capacity() + slots.capacity() * sizeof(Slot) + keys.memoryBytes();
+    }
+
+    // Function to estimate the footprint with a std::string in every slot (the previous layout)
+    size_t stringSlotBytes() const {
+        struct StringSlot {
+            std::uint64_t hash;
+            std::string key;
+            int value;
+        };
+        return control.capacity() + slots.capacity() * sizeof(StringSlot) +
+               keys.stringVectorBytes() - keys.size() * sizeof(std::string);
+    }
+};
@@ -9,26 +9,410 @@
 
 #include "EncoderDictionary.h" // Core data structure and helpers
 #include <chrono>              // Timing tasks
+#include <iomanip>             // std::setw (build scaling table)
+#include <map>                 // std::map (baseline for the trie benchmark)
+#include <random>              // Sampling lookup keys
+#include <x86intrin.h>          // __rdtsc (cycle counts for the packed scans)
+
+// Function to report the memory of the loaded column and dictionary, before and after the string arenas
+//  "Before" is the std::string per row (std::vector<std::string>) and per table slot layout.
+void reportMemory(EncoderDictionary& d, const StringArena& inputraw) {
+    size_t rows = std::max<size_t>(1, inputraw.size());
+    size_t keys = std::max<size_t>(1, d.size());
+    std::cout << "Raw column: " << inputraw.size() << " rows, " << double(inputraw.byteSize()) / rows
+              << " string bytes per row.\n";
+    std::cout << "  std::vector<std::string>: ~" << inputraw.stringVectorBytes() << " bytes ("
+              << double(inputraw.stringVectorBytes()) / rows << " per row)\n";
+    std::cout << "  StringArena: " << inputraw.memoryBytes() << " bytes ("
+              << double(inputraw.memoryBytes()) / rows << " per row)\n";
+    std::cout << "Dictionary: " << d.size() << " keys.\n";
+    std::cout << "  std::string slots: ~" << d.stringSlotBytes() << " bytes ("
+              << double(d.stringSlotBytes()) / keys << " per key)\n";
+    std::cout << "  Arena-backed slots: " << d.memoryBytes() << " bytes ("
+              << double(d.memoryBytes()) / keys << " per key)\n" << std::endl;
+}
+
+// Function to compare the succinct trie against a std::map dictionary on memory and queries
+void benchmarkTrie(EncoderDictionary& d, const StringArena& inputraw, const std::string& prefix) {
+    using clock = std::chrono::high_resolution_clock;
+    auto usec = [](clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    };
+
+    // The original dictionary structure, plus a reverse table so it can decode as well
+    std::map<std::string, int, std::less<>> map; // Transparent, so string_view lookups do not copy
+    std::vector<const std::string*> byCode(d.size());
+    size_t keyBytes = 0;
+    size_t heapStringBytes = 0;
+    d.forEachSorted([&](std::string_view key, int value) {
+        auto it = map.emplace_hint(map.end(), key, value);
+        byCode[value] = &it->first;
+        keyBytes += key.size();
+        heapStringBytes += (key.size() > 15) ? key.size() + 1 : 0; // Past the small-string buffer
+    });
+    auto start = clock::now();
+    SuccinctTrie trie = buildSuccinctTrie(d);
+    std::cout << "Succinct trie built over " << trie.size() << " keys in " << usec(start) << " usec.\n";
+
+    // Memory (the map figure counts a red-black node header plus the key/value pair per entry)
+    size_t mapBytes = map.size() * (32 + sizeof(std::pair<const std::string, int>)) + heapStringBytes;
+    std::cout << "Raw key bytes: " << keyBytes << " (" << double(keyBytes) / map.size() << " per key)\n";
+    std::cout << "std::map: ~" << mapBytes << " bytes (" << double(mapBytes) / map.size() << " per key)\n";
+    std::cout << "Succinct trie: " << trie.memoryBytes() << " bytes (" << double(trie.memoryBytes()) / map.size()
+              << " per key, " << 100.0 * trie.memoryBytes() / keyBytes << "% of raw key bytes): "
+              << trie.structureBytes() << " of labels, shape and tails + " << trie.codeBytes() << " of "
+              << (trie.hasCodesInKeyOrder() ? "subtree key counts (codes in key order)" : "bit-packed code mappings")
+              << "\n";
+
+    // Exact lookups of rows sampled from the column
+    std::mt19937 rng(42);
+    std::vector<std::string_view> sample(std::min<size_t>(200000, inputraw.size()));
+    for (auto& key : sample) {
+        key = inputraw[rng() % inputraw.size()];
+    }
+    size_t mismatches = 0;
+    long long checksum = 0;
+    start = clock::now();
+    for (std::string_view key : sample) {
+        checksum += map.find(key)->second;
+    }
+    auto mapLookup = usec(start);
+    start = clock::now();
+    for (std::string_view key : sample) {
+        checksum -= trie.getEncoding(key);
+    }
+    auto trieLookup = usec(start);
+    mismatches += (checksum != 0);
+    std::cout << "Exact lookup of " << sample.size() << " rows: std::map " << mapLookup << " usec, trie "
+              << trieLookup << " usec.\n";
+
+    // The prefix query, plus every single-letter prefix
+    std::vector<std::string> prefixes = {prefix};
+    for (char c = 'a'; c <= 'z'; ++c) {
+        prefixes.push_back(std::string(1, c));
+    }
+    long long mapPrefix = 0;
+    long long triePrefix = 0;
+    for (const std::string& p : prefixes) {
+        start = clock::now();
+        std::vector<int> expected;
+        auto lower = map.lower_bound(p);
+        auto upper = map.upper_bound(p + char(255));
+        for (auto it = lower; it != upper; ++it) {
+            expected.push_back(it->second);
+        }
+        mapPrefix += usec(start);
+        start = clock::now();
+        std::vector<int> codes = trie.getEncodingValuesWithPrefix(p);
+        triePrefix += usec(start);
+        mismatches += (codes != expected);
+    }
+    std::cout << "Prefix enumeration (" << prefixes.size() << " prefixes): std::map " << mapPrefix
+              << " usec, trie " << triePrefix << " usec.\n";
+
+    // Decode every code back to its key
+    start = clock::now();
+    for (size_t code = 0; code < byCode.size(); ++code) {
+        mismatches += (trie.decode(code) != *byCode[code]);
+    }
+    std::cout << "Decoded all " << byCode.size() << " codes in " << usec(start) << " usec.\n";
+    std::cout << "Trie results " << (mismatches == 0 ? "match" : "DIFFER") << " (" << mismatches
+              << " mismatching checks).\n" << std::endl;
+}
+
+// Function to compare predicate scans on the bit-sliced column against the scans over 32-bit codes
+//  Cycle counts are time-stamp counter ticks, so codes per cycle is relative to the TSC frequency.
+void benchmarkPackedScan(EncoderDictionary& d, const std::vector<int>& inputencoded, const std::string& prefix) {
+    using clock = std::chrono::high_resolution_clock;
+    auto usec = [](clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    };
+    size_t rows = inputencoded.size();
+    if (rows == 0) {
+        return;
+    }
+    size_t mismatches = 0;
+
+    unsigned width = encodedBitWidth(d.size());
+    BitSlicedColumn column;
+    auto start = clock::now();
+    column.build(inputencoded, width);
+    std::cout << "Bit-sliced column: " << rows << " rows at " << width << " bits, " << column.memoryBytes()
+              << " bytes (" << rows * sizeof(int) << " as 32-bit codes), built in " << usec(start) << " usec.\n";
+
+    // Best of five runs (first runs also pay for page faults on freshly allocated results)
+    auto bestOf = [](auto scan, double& cycles) {
+        long long best = 0;
+        for (int run = 0; run < 5; ++run) {
+            auto begin = clock::now();
+            unsigned long long ticks = __rdtsc();
+            scan();
+            double spent = __rdtsc() - ticks;
+            long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - begin).count();
+            if (run == 0 || spent < cycles) {
+                cycles = spent;
+                best = elapsed;
+            }
+        }
+        return best;
+    };
+
+    // Equality: the key of the middle row, against the 4-wide SSE scan
+    int targetCode = inputencoded[rows / 2];
+    std::string target;
+    d.forEachSorted([&](std::string_view key, int value) {
+        if (value == targetCode) {
+            target = key;
+        }
+    });
+    std::vector<int> sseHits;
+    std::vector<int> packedHits;
+    std::vector<std::uint64_t> bitmap;
+    double sseCycles = 0;
+    double packedCycles = 0;
+    auto sseTime = bestOf([&] {
+        sseHits.clear();
+        searchEncodedSIMD(inputencoded, d, target, sseHits);
+    }, sseCycles);
+    auto bitmapTime = bestOf([&] { column.equalTo(targetCode, bitmap); }, packedCycles);
+    start = clock::now();
+    bitmapToLocations(bitmap, packedHits);
+    auto listTime = usec(start);
+    std::vector<int> scalarHits; // Plain scalar scan as the reference for both
+    searchEncoded(inputencoded, d, target, scalarHits);
+    mismatches += (sseHits != scalarHits) + (packedHits != scalarHits);
+    std::vector<int> searchHits;
+    mismatches += !searchEncodedPacked(column, d, target, searchHits) || (searchHits != scalarHits);
+    std::cout << "Equality on " << target << " (" << packedHits.size() << " rows): 4-wide SSE " << sseTime
+              << " usec (" << rows / sseCycles << " codes/cycle), bit-sliced bitmap " << bitmapTime << " usec ("
+              << rows / packedCycles << " codes/cycle) + " << listTime << " usec to list rows.\n";
+
+    // Range: the prefix's code interval with order-preserving codes, otherwise 1% of the codes
+    int lo = 0;
+    int hi = 0;
+    std::string rangeName = "prefix " + prefix;
+    if (!d.getCodeRangeWithPrefix(prefix, lo, hi)) {
+        lo = static_cast<int>(d.size() / 4);
+        hi = lo + static_cast<int>(std::max<size_t>(1, d.size() / 100));
+        rangeName = "1% of the codes";
+    }
+    std::vector<int> avxHits;
+    packedHits.clear();
+    double avxCycles = 0;
+    auto avxTime = bestOf([&] {
+        avxHits.clear();
+        rangeSearchEncodedSIMD(inputencoded, lo, hi, avxHits);
+    }, avxCycles);
+    bitmapTime = bestOf([&] { column.inRange(lo, hi, bitmap); }, packedCycles);
+    bitmapToLocations(bitmap, packedHits);
+    mismatches += (avxHits != packedHits);
+    std::cout << "Range [" << lo << ", " << hi << ") = " << rangeName << " (" << packedHits.size()
+              << " rows): 8-wide AVX2 " << avxTime << " usec (" << rows / avxCycles << " codes/cycle), bit-sliced bitmap "
+              << bitmapTime << " usec (" << rows / packedCycles << " codes/cycle).\n";
+
+    // Every width from 1 to 32 on random codes, checked against a scalar scan
+    std::cout << "Width sweep on " << rows << " random codes (codes/cycle, equality / range):";
+    std::mt19937 rng(7);
+    std::vector<int> synthetic(rows);
+    for (unsigned w = 1; w <= 32; ++w) {
+        std::uint32_t mask = (w == 32) ? ~0u : (1u << w) - 1;
+        for (int& code : synthetic) {
+            code = static_cast<int>(rng() & mask);
+        }
+        BitSlicedColumn sweep;
+        sweep.build(synthetic, w);
+        std::uint32_t code = static_cast<std::uint32_t>(synthetic[rows / 3]);
+        std::uint32_t low = std::min<std::uint32_t>(rng() & mask, code);
+        std::uint32_t high = low + (mask - low) / 4 + 1;
+        double eqCycles = 0;
+        double rangeCycles = 0;
+        std::vector<std::uint64_t> ranged;
+        bestOf([&] { sweep.equalTo(code, bitmap); }, eqCycles);
+        bestOf([&] { sweep.inRange(low, high, ranged); }, rangeCycles);
+        for (size_t i = 0; i < rows; ++i) {
+            std::uint32_t value = static_cast<std::uint32_t>(synthetic[i]);
+            bool selected = (bitmap[i / 64] >> (i % 64)) & 1;
+            bool inside = (ranged[i / 64] >> (i % 64)) & 1;
+            mismatches += (selected != (value == code)) + (inside != (value >= low && value < high));
+        }
+        if (w == 1 || w % 4 == 0) {
+            std::cout << (w % 16 == 4 ? "\n " : "") << " w" << w << ": " << rows / eqCycles << " / "
+                      << rows / rangeCycles;
+        }
+    }
+    std::cout << "\nBit-sliced results " << (mismatches == 0 ? "match" : "DIFFER") << " (" << mismatches
+              << " mismatching checks).\n" << std::endl;
+}
+
+// Function to check that encoded files round-trip: the loaded column against the raw rows, then
+//  synthetic dictionaries of power-of-two sizes, where the largest code is all ones at the column's
+//  width, and a column with a missing key (-1), which the writer must refuse.
+bool checkEncodedRoundTrip(EncoderDictionary& d, const StringArena& inputraw, const std::vector<int>& inputencoded,
+                           const std::string& scratchpath) {
+    size_t mismatches = 0;
+    std::vector<std::string_view> keyOf(d.size());
+    d.forEachSorted([&](std::string_view key, int value) {
+        keyOf[value] = key;
+    });
+    mismatches += (inputencoded.size() != inputraw.size());
+    for (size_t i = 0; i < std::min(inputencoded.size(), inputraw.size()); ++i) {
+        mismatches += (keyOf[inputencoded[i]] != inputraw[i]);
+    }
+    std::cout << "Loaded column decodes to the raw rows: " << (mismatches == 0 ? "yes" : "NO") << ".\n";
+
+    std::mt19937 rng(11);
+    for (unsigned width : {1u, 2u, 3u, 8u, 16u}) {
+        size_t keys = size_t(1) << width;
+        EncoderDictionary synthetic;
+        for (size_t code = 0; code < keys; ++code) {
+            synthetic.setKey("key" + std::to_string(code), static_cast<int>(code));
+        }
+        std::vector<int> codes(keys + 1000);
+        for (size_t i = 0; i < codes.size(); ++i) {
+            codes[i] = static_cast<int>(i < keys ? keys - 1 - i : rng() % keys); // Every code, all ones first
+        }
+        std::vector<int> back;
+        bool written = writeEncodedFile(scratchpath, {&codes}, synthetic);
+        bool read = written && readEncodedFile(scratchpath, back, synthetic);
+        size_t wrong = (encodedBitWidth(keys) != width) + !read + (back != codes);
+        mismatches += wrong;
+        std::cout << "  " << keys << " keys at " << encodedBitWidth(keys) << " bits: "
+                  << (wrong == 0 ? "round-trips" : "DIFFERS") << ".\n";
+    }
+
+    EncoderDictionary four;
+    for (int code = 0; code < 4; ++code) {
+        four.setKey("key" + std::to_string(code), code);
+    }
+    std::vector<int> withMissing = {0, 3, -1, 2};
+    std::cout << "  Missing key (expect an error):\n";
+    bool refused = !writeEncodedFile(scratchpath, {&withMissing}, four) && !std::ifstream(scratchpath).good();
+    mismatches += !refused;
+    std::cout << "  Missing key " << (refused ? "refused, no file left" : "was WRITTEN") << ".\n";
+    std::cout << "Round-trip results " << (mismatches == 0 ? "match" : "DIFFER") << " (" << mismatches
+              << " mismatching checks).\n" << std::endl;
+    return mismatches == 0;
+}
+
+// Function to time the sharded dictionary build at 1, 2, 4, ... up to maxThreads threads
+//  Each run builds a fresh dictionary (best of three, no files written). The key-order checksum
+//  must match the single-thread build, since thread count only changes which key gets which code.
+bool benchmarkBuildScaling(const std::string& filepath_in, size_t maxThreads) {
+    using clock = std::chrono::high_resolution_clock;
+    MappedFile file_in(filepath_in);
+    if (!file_in.isOpen()) {
+        return false;
+    }
+    std::vector<size_t> counts;
+    for (size_t t = 1; t < maxThreads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(maxThreads);
+
+    std::cout << "Dictionary build scaling (" << std::thread::hardware_concurrency() << " hardware threads):\n";
+    std::cout << "  threads   build (usec)   speedup   contended locks\n";
+    long long baseline = 0;
+    std::uint64_t baseChecksum = 0;
+    size_t mismatches = 0;
+    for (size_t threadCount : counts) {
+        long long best = 0;
+        unsigned long long contended = 0;
+        for (int run = 0; run < 3; ++run) {
+            EncoderDictionary d;
+            std::vector<std::vector<int>> codes(threadCount);
+            std::vector<std::string_view> ranges = file_in.splitLines(threadCount);
+            auto start = clock::now();
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < threadCount; ++i) {
+                threads.emplace_back([&, i](){ asyncProcessor(ranges[i], d, codes[i]); });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+            if (run == 0 || elapsed < best) {
+                best = elapsed;
+                contended = 0;
+                for (const ShardContention& shard : d.shardContention()) {
+                    contended += shard.contended;
+                }
+            }
+            if (run == 0) {
+                d.assignSortedCodes();
+                if (threadCount == 1) {
+                    baseChecksum = d.checksum();
+                }
+                mismatches += (d.checksum() != baseChecksum);
+            }
+        }
+        if (threadCount == 1) {
+            baseline = best;
+        }
+        std::cout << "  " << std::setw(7) << threadCount << "   " << std::setw(12) << best << "   "
+                  << std::setw(6) << std::fixed << std::setprecision(2) << double(baseline) / std::max(1LL, best)
+                  << "x   " << std::setw(15) << contended << '\n';
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << "Build scaling dictionaries " << (mismatches == 0 ? "match" : "DIFFER") << " (" << mismatches
+              << " mismatching thread counts).\n" << std::endl;
+    return mismatches == 0;
+}
 
 int main(int argc, char* argv[]) {
     if (argc < 5) { // Ensure correct commandline arguments
         std::cerr << "Usage: " << argv[0] << " <path/to/input.txt>"
             " <path/to/output.txt> <path/to/dictionary.txt>"
-            " <regenerate dict/encfile? [1/0]>" << '\n';
+            " <regenerate dict/encfile? [1/0]> [--threads <n>] [--two-phase] [--sorted-codes] [--trie] [--packed-scan] [--round-trip] [--build-scaling <max threads>]" << '\n';
         return 1;   // Return an error code
     }
     std::string filepath_in = argv[1];
     std::string filepath_out = argv[2];
     std::string dictpath = argv[3];
     int no_dict = atoi(argv[4]);
+    size_t num_threads = 0; // Dictionary build threads (0 = all hardware threads)
+    bool two_phase = false; // Thread-local dictionaries + deterministic merge
+    bool sorted_codes = false; // Codes in key order, so prefixes become code intervals
+    bool trie_bench = false; // Compare the succinct trie with std::map
+    bool packed_bench = false; // Compare scans on the bit-sliced column with the 32-bit scans
+    bool round_trip = false; // Check the encoded file format round-trips (writes a scratch file)
+    size_t scaling_threads = 0; // Time the dictionary build at 1, 2, 4, ... up to this many threads
+    // Optional trailing flags
+    for (int i = 5; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--threads" && i + 1 < argc) {
+            num_threads = std::max(1, atoi(argv[++i]));
+        } else if (flag == "--two-phase") {
+            two_phase = true;
+        } else if (flag == "--sorted-codes") {
+            sorted_codes = true;
+        } else if (flag == "--trie") {
+            trie_bench = true;
+        } else if (flag == "--packed-scan") {
+            packed_bench = true;
+        } else if (flag == "--round-trip") {
+            round_trip = true;
+        } else if (flag == "--build-scaling" && i + 1 < argc) {
+            scaling_threads = std::max(1, atoi(argv[++i]));
+        } else {
+            std::cerr << "Unknown option " << flag << '\n';
+            return 1;
+        }
+    }
 
     EncoderDictionary dictionary; // The dictionary itself - how we translate between input and encoded
-    std::vector<std::string> inputraw; // The input as it is in its txt
-    std::vector<int> inputencoded; // The encoded input as it is in its txt
+    StringArena inputraw; // The input as it is in its txt (one arena of row bytes)
+    std::vector<int> inputencoded; // The encoded input, unpacked from its bit-packed file
+
+    if (scaling_threads > 0 && !benchmarkBuildScaling(filepath_in, scaling_threads)) {
+        return 1;
+    }
 
     if (no_dict) { // If the command line option to create a dictionary and encfile was selected
-        createDictionary(filepath_in, dictpath, dictionary);
-        createEncodedFile(filepath_in, filepath_out, dictionary);
+        if (two_phase) {
+            createDictionaryTwoPhase(filepath_in, dictpath, filepath_out, dictionary, num_threads, sorted_codes);
+        } else {
+            createDictionary(filepath_in, dictpath, filepath_out, dictionary, num_threads, sorted_codes);
+        }
     }
 
     std::cout << "\nLoading files." << "\n";
@@ -36,10 +420,27 @@ int main(int argc, char* argv[]) {
     // Assumption that dictpath, filepath_in, and filepath_out are all populated
     readDictionary(dictpath, dictionary);
     readInputFile(filepath_in, inputraw);
-    readEncodedFile(filepath_out, inputencoded);
+    auto starte = std::chrono::high_resolution_clock::now();
+    if (!readEncodedFile(filepath_out, inputencoded, dictionary)) {
+        return 1;
+    }
     auto stopl = std::chrono::high_resolution_clock::now();
-    auto durationl = std::chrono::duration_cast<std::chrono::seconds>(stopl - startl);
-    std::cout << "Files loaded. Time elapsed: " << durationl.count() << " sec.\n" << std::endl;
+    auto duratione = std::chrono::duration_cast<std::chrono::milliseconds>(stopl - starte);
+    auto durationl = std::chrono::duration_cast<std::chrono::milliseconds>(stopl - startl);
+    std::cout << "Encoded file loaded (" << inputencoded.size() << " rows). Time elapsed: " << duratione.count()
+              << " msec.\n";
+    std::cout << "Files loaded. Time elapsed: " << durationl.count() << " msec.\n" << std::endl;
+    reportMemory(dictionary, inputraw);
+
+    if (trie_bench) {
+        benchmarkTrie(dictionary, inputraw, "ap");
+    }
+    if (packed_bench) {
+        benchmarkPackedScan(dictionary, inputencoded, "ap");
+    }
+    if (round_trip && !checkEncodedRoundTrip(dictionary, inputraw, inputencoded, filepath_out + ".roundtrip")) {
+        return 1;
+    }
 
     // TESTING PARAMETERS
     // const std::string searchterm = "wzulz";
@@ -158,6 +559,56 @@ int main(int argc, char* argv[]) {
     duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
     std::cout << "ENCAVX Time elapsed: " << duration.count() << " usec.\n" << std::endl;
 
+
+    // TESTING ENCODED CODE-RANGE PREFIX SEARCH (order-preserving codes only)
+    if (dictionary.orderPreserving()) {
+        hits.clear();
+        std::cout << "Searching for targets matching prefix " << prefix << " using method ENCRNG" << "\n";
+        start = std::chrono::high_resolution_clock::now();
+        if (!prefixSearchEncodedRange(inputencoded, dictionary, prefix, hits)) {
+            std::cout << "Targets matching prefix " << prefix << " do not exist in the dataset." << "\n";
+            exit(0);
+        }
+        stop = std::chrono::high_resolution_clock::now();
+        std::cout << "Targets matching prefix " << prefix << " found at location(s): ";
+        for (size_t i = 0; i < hits.size(); ++i) {
+            std::cout << hits[i] << " ";
+        }
+        std::cout << "\n";
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+        std::cout << "ENCRNG Time elapsed: " << duration.count() << " usec.\n" << std::endl;
+    } else {
+        std::cout << "Method ENCRNG skipped: codes are not in key order (build with --sorted-codes)." << "\n";
+    }
+
+
+    // TESTING BIT-SLICED CODE-RANGE PREFIX SEARCH (order-preserving codes only)
+    if (dictionary.orderPreserving()) {
+        hits.clear();
+        start = std::chrono::high_resolution_clock::now();
+        BitSlicedColumn packed;
+        packed.build(inputencoded, encodedBitWidth(dictionary.size()));
+        stop = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+        std::cout << "Bit-sliced column built in " << duration.count() << " usec (once per loaded column)." << "\n";
+        std::cout << "Searching for targets matching prefix " << prefix << " using method ENCPCK" << "\n";
+        start = std::chrono::high_resolution_clock::now();
+        if (!prefixSearchEncodedPacked(packed, dictionary, prefix, hits)) {
+            std::cout << "Targets matching prefix " << prefix << " do not exist in the dataset." << "\n";
+            exit(0);
+        }
+        stop = std::chrono::high_resolution_clock::now();
+        std::cout << "Targets matching prefix " << prefix << " found at location(s): ";
+        for (size_t i = 0; i < hits.size(); ++i) {
+            std::cout << hits[i] << " ";
+        }
+        std::cout << "\n";
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+        std::cout << "ENCPCK Time elapsed: " << duration.count() << " usec.\n" << std::endl;
+    } else {
+        std::cout << "Method ENCPCK skipped: codes are not in key order (build with --sorted-codes)." << "\n";
+    }
+
     std::cout.flush();
     return 0;
 }
\ No newline at end of file